@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# 按钮绘制与动画性能测试（无界面运行）
+# 运行：./ButtonBenchmark [每种按钮数量] [帧数]
+# 由 WindowsButtons.pro 统一编译，链接 interactive_buttons 静态库
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = ButtonBenchmark
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+CONFIG += interactive_buttons_link
+include(../interactive_buttons/interactive_buttons.pri)
+
+SOURCES += \
+        main.cpp
@@ -0,0 +1,333 @@
+#include <QApplication>
+#include <QImage>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QList>
+#include <QHash>
+#include <QByteArray>
+#include <functional>
+#include <cstdlib>
+#include <new>
+#include "interactivebuttonbase.h"
+#include "watercirclebutton.h"
+#include "waterfloatbutton.h"
+#include "threedimenbutton.h"
+#include "waterzoombutton.h"
+#include "winclosebutton.h"
+#include "winminbutton.h"
+#include "winmaxbutton.h"
+#include "winrestorebutton.h"
+#include "winmenubutton.h"
+#include "pointmenubutton.h"
+
+#define DEFAULT_BUTTON_COUNT 100 // 每种按钮的数量
+#define DEFAULT_FRAME_COUNT 300  // 每种按钮的帧数
+#define SEQUENCE_FRAMES 60       // 一次 悬浮-按下-松开-离开 的帧数
+#define FRAME_MSECS 16           // 每帧步进的虚拟时间（毫秒）
+#define STARTUP_COLUMNS 100      // 启动测试中每行的按钮数量
+#define STARTUP_BUTTON_W 32      // 启动测试中按钮的尺寸
+#define STARTUP_BUTTON_H 20
+
+/**
+ * 统计堆内存分配次数
+ */
+static qint64 allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+    allocation_count++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * 一种按钮的测试用例
+ */
+struct BenchmarkCase
+{
+    QString name;
+    QSize size;
+    std::function<InteractiveButtonBase*(QWidget*)> create;
+};
+
+/**
+ * 一种按钮的测试结果
+ */
+struct BenchmarkResult
+{
+    BenchmarkResult() : tick_nsecs(0), paint_nsecs(0), ticks(0), paints(0), allocations(0), checksum(0) {}
+    qint64 tick_nsecs, paint_nsecs; // 累计耗时
+    qint64 ticks, paints;           // 次数
+    qint64 allocations;             // 堆内存分配次数
+    uint checksum;                  // 所有帧画面的校验值，相同参数多次运行应当一致
+};
+
+static void sendMouseEvent(QWidget* widget, QEvent::Type type, QPoint pos, Qt::MouseButton button, Qt::MouseButtons buttons)
+{
+    QMouseEvent event(type, pos, widget->mapToGlobal(pos), button, buttons, Qt::NoModifier);
+    QApplication::sendEvent(widget, &event);
+}
+
+/**
+ * 模拟的鼠标操作：移入、按下、拖动、松开、移出
+ * @param phase 当前帧在一次操作中的位置
+ */
+static void driveSequence(InteractiveButtonBase* btn, int phase, QPoint center, QPoint aside)
+{
+    if (phase == 0)
+    {
+        QEvent enter(QEvent::Enter);
+        QApplication::sendEvent(btn, &enter);
+        sendMouseEvent(btn, QEvent::MouseMove, center, Qt::NoButton, Qt::NoButton);
+    }
+    else if (phase == 10)
+    {
+        sendMouseEvent(btn, QEvent::MouseButtonPress, center, Qt::LeftButton, Qt::LeftButton);
+    }
+    else if (phase == 15)
+    {
+        sendMouseEvent(btn, QEvent::MouseMove, aside, Qt::NoButton, Qt::LeftButton);
+    }
+    else if (phase == 25)
+    {
+        sendMouseEvent(btn, QEvent::MouseButtonRelease, aside, Qt::LeftButton, Qt::NoButton);
+    }
+    else if (phase == 45)
+    {
+        QEvent leave(QEvent::Leave);
+        QApplication::sendEvent(btn, &leave);
+    }
+}
+
+/**
+ * 运行一种按钮：每帧依次刷新动画、绘制到图片
+ * 使用手动时钟，每帧固定步进，动画进度与机器快慢无关
+ */
+static BenchmarkResult runCase(const BenchmarkCase& c, int count, int frames)
+{
+    ManualAnimationClock clock;
+    ButtonAnimationDriver::instance()->setClock(&clock);
+
+    QWidget container;
+    container.resize(c.size);
+    QList<InteractiveButtonBase*> buttons;
+    for (int i = 0; i < count; i++)
+    {
+        InteractiveButtonBase* btn = c.create(&container);
+        btn->setGeometry(QRect(QPoint(0, 0), c.size));
+        buttons.append(btn);
+    }
+
+    QImage image(c.size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPoint center(c.size.width() / 2, c.size.height() / 2);
+    QPoint aside = center + QPoint(c.size.width() / 4, c.size.height() / 4);
+
+    BenchmarkResult result;
+    QElapsedTimer timer;
+    qint64 allocation_start = allocation_count;
+    for (int f = 0; f < frames; f++)
+    {
+        clock.advance(FRAME_MSECS);
+        int phase = f % SEQUENCE_FRAMES;
+        foreach (InteractiveButtonBase* btn, buttons)
+        {
+            driveSequence(btn, phase, center, aside);
+
+            timer.start();
+            btn->anchorTimeOut();
+            result.tick_nsecs += timer.nsecsElapsed();
+            result.ticks++;
+
+            image.fill(Qt::transparent);
+            timer.start();
+            btn->render(&image);
+            result.paint_nsecs += timer.nsecsElapsed();
+            result.paints++;
+        }
+        result.checksum = result.checksum * 31 + qHash(QByteArray::fromRawData(
+                              reinterpret_cast<const char*>(image.constBits()), static_cast<int>(image.sizeInBytes())));
+    }
+    result.allocations = allocation_count - allocation_start;
+
+    ButtonAnimationDriver::instance()->setClock(nullptr);
+    return result;
+}
+
+/**
+ * 一次启动测试的结果
+ */
+struct StartupResult
+{
+    StartupResult() : create_nsecs(0), frame_nsecs(0), allocations(0) {}
+    qint64 create_nsecs; // 创建并设置所有按钮的耗时
+    qint64 frame_nsecs;  // 显示并绘制第一帧的耗时
+    qint64 allocations;  // 创建过程中的堆内存分配次数
+};
+
+/**
+ * 启动测试：创建 count 个按钮，显示窗口并绘制第一帧
+ * @param bulk 是否使用 InteractiveButtonBase::createButtons 批量创建
+ */
+static StartupResult runStartup(int count, bool bulk)
+{
+    int rows = (count + STARTUP_COLUMNS - 1) / STARTUP_COLUMNS;
+    QWidget container;
+    container.resize(STARTUP_COLUMNS * STARTUP_BUTTON_W, rows * STARTUP_BUTTON_H);
+    QList<QRect> geometries;
+    for (int i = 0; i < count; i++)
+        geometries << QRect((i % STARTUP_COLUMNS) * STARTUP_BUTTON_W, (i / STARTUP_COLUMNS) * STARTUP_BUTTON_H,
+                            STARTUP_BUTTON_W, STARTUP_BUTTON_H);
+
+    StartupResult result;
+    QElapsedTimer timer;
+    qint64 allocation_start = allocation_count;
+    timer.start();
+    if (bulk)
+    {
+        InteractiveButtonStyle style;
+        style.setNormalColor(QColor(240, 240, 240));
+        style.setHoverColor(QColor(100, 149, 237, 128));
+        style.setPressColor(QColor(100, 149, 237));
+        style.setRadius(3, 3);
+        QList<InteractiveButtonBase::ButtonDescriptor> descriptors;
+        descriptors.reserve(count);
+        for (int i = 0; i < count; i++)
+            descriptors << InteractiveButtonBase::ButtonDescriptor(QString::number(i), geometries.at(i));
+        InteractiveButtonBase::createButtons(descriptors, style, &container);
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            InteractiveButtonBase* btn = new InteractiveButtonBase(QString::number(i), &container);
+            btn->setNormalColor(QColor(240, 240, 240));
+            btn->setBgColor(QColor(100, 149, 237, 128), QColor(100, 149, 237));
+            btn->setRadius(3);
+            btn->setGeometry(geometries.at(i));
+        }
+    }
+    result.create_nsecs = timer.nsecsElapsed();
+    result.allocations = allocation_count - allocation_start;
+
+    QImage image(container.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    timer.start();
+    container.show();
+    container.render(&image);
+    result.frame_nsecs = timer.nsecsElapsed();
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    // 无界面运行
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication a(argc, argv);
+    QStringList args = a.arguments();
+    int count = args.size() > 1 ? args.at(1).toInt() : DEFAULT_BUTTON_COUNT;
+    int frames = args.size() > 2 ? args.at(2).toInt() : DEFAULT_FRAME_COUNT;
+    if (count <= 0)
+        count = DEFAULT_BUTTON_COUNT;
+    if (frames <= 0)
+        frames = DEFAULT_FRAME_COUNT;
+
+    QList<BenchmarkCase> cases;
+    cases << BenchmarkCase{ "InteractiveButtonBase", QSize(120, 40), [](QWidget* p) -> InteractiveButtonBase* {
+        InteractiveButtonBase* btn = new InteractiveButtonBase("text", p);
+        btn->setRadius(5);
+        return btn;
+    }};
+    cases << BenchmarkCase{ "WaterCircleButton", QSize(40, 40), [](QWidget* p) -> InteractiveButtonBase* {
+        return new WaterCircleButton(p);
+    }};
+    cases << BenchmarkCase{ "WaterFloatButton", QSize(120, 32), [](QWidget* p) -> InteractiveButtonBase* {
+        return new WaterFloatButton("text", p);
+    }};
+    cases << BenchmarkCase{ "ThreeDimenButton", QSize(200, 100), [](QWidget* p) -> InteractiveButtonBase* {
+        return new ThreeDimenButton(p);
+    }};
+    cases << BenchmarkCase{ "WaterZoomButton", QSize(200, 50), [](QWidget* p) -> InteractiveButtonBase* {
+        WaterZoomButton* btn = new WaterZoomButton("text", p);
+        btn->setRadius(10, 5);
+        btn->setChokingProp(0.18);
+        return btn;
+    }};
+    cases << BenchmarkCase{ "WinCloseButton", QSize(32, 32), [](QWidget* p) -> InteractiveButtonBase* {
+        WinCloseButton* btn = new WinCloseButton(p);
+        btn->setTopRightRadius(5);
+        return btn;
+    }};
+    cases << BenchmarkCase{ "WinMinButton", QSize(32, 32), [](QWidget* p) -> InteractiveButtonBase* {
+        return new WinMinButton(p);
+    }};
+    cases << BenchmarkCase{ "WinMaxButton", QSize(32, 32), [](QWidget* p) -> InteractiveButtonBase* {
+        return new WinMaxButton(p);
+    }};
+    cases << BenchmarkCase{ "WinRestoreButton", QSize(32, 32), [](QWidget* p) -> InteractiveButtonBase* {
+        return new WinRestoreButton(p);
+    }};
+    cases << BenchmarkCase{ "WinMenuButton", QSize(32, 32), [](QWidget* p) -> InteractiveButtonBase* {
+        return new WinMenuButton(p);
+    }};
+    cases << BenchmarkCase{ "PointMenuButton", QSize(100, 100), [](QWidget* p) -> InteractiveButtonBase* {
+        return new PointMenuButton(p);
+    }};
+
+    QTextStream out(stdout);
+    out << QString("buttons per type: %1, frames: %2\n").arg(count).arg(frames);
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+           .arg("type", -24).arg("fps", 10).arg("us/tick", 10).arg("us/paint", 10).arg("allocs/frame", 14).arg("checksum", 10);
+    foreach (const BenchmarkCase& c, cases)
+    {
+        BenchmarkResult r = runCase(c, count, frames);
+        double total_secs = (r.tick_nsecs + r.paint_nsecs) / 1e9;
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg(c.name, -24)
+               .arg(total_secs > 0 ? frames / total_secs : 0, 10, 'f', 1)
+               .arg(r.ticks ? r.tick_nsecs / 1000.0 / r.ticks : 0, 10, 'f', 2)
+               .arg(r.paints ? r.paint_nsecs / 1000.0 / r.paints : 0, 10, 'f', 2)
+               .arg(static_cast<double>(r.allocations) / frames, 14, 'f', 1)
+               .arg(r.checksum, 10, 16, QChar('0'));
+        out.flush();
+    }
+
+    // 启动：创建到第一帧的耗时
+    out << QString("\n%1 %2 %3 %4 %5 %6\n")
+           .arg("startup", -24).arg("buttons", 10).arg("create ms", 10).arg("frame ms", 10).arg("total ms", 10).arg("allocs/btn", 14);
+    foreach (int n, QList<int>() << 1000 << 10000)
+    {
+        for (int bulk = 0; bulk < 2; bulk++)
+        {
+            StartupResult r = runStartup(n, bulk);
+            out << QString("%1 %2 %3 %4 %5 %6\n")
+                   .arg(bulk ? "createButtons" : "constructor", -24)
+                   .arg(n, 10)
+                   .arg(r.create_nsecs / 1e6, 10, 'f', 2)
+                   .arg(r.frame_nsecs / 1e6, 10, 'f', 2)
+                   .arg((r.create_nsecs + r.frame_nsecs) / 1e6, 10, 'f', 2)
+                   .arg(static_cast<double>(r.allocations) / n, 14, 'f', 1);
+            out.flush();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,390 @@
+#include "buttonanimationdriver.h"
+#include <QGuiApplication>
+#include <QCursor>
+
+ButtonAnimationDriver* ButtonAnimationDriver::driver = nullptr;
+
+/**
+ * 析构时移出驱动器队列，避免悬空指针
+ */
+AnimationTarget::~AnimationTarget()
+{
+    if (animation_queued && ButtonAnimationDriver::hasInstance())
+        ButtonAnimationDriver::instance()->removeTarget(this);
+}
+
+ButtonAnimationDriver::ButtonAnimationDriver(QObject *parent)
+    : QObject(parent), active_count(0), ticking(false), frame_nsecs(0), frame_index(0), cursor_frame(-1),
+      frame_policy(FollowScreen), fixed_interval(ANIMATION_INTERVAL), max_frame_rate(0),
+      frame_skipping(true), paint_cost_nsecs(0), frame_cost_nsecs(0), skip_frames(0),
+      clock(nullptr)
+{
+    // 无需改代码即可限制帧率（例如 X11 转发、VNC 远程桌面）
+    int env_fps = qEnvironmentVariableIntValue("INTERACTIVE_BUTTONS_MAX_FPS");
+    if (env_fps > 0)
+        max_frame_rate = env_fps;
+
+    frame_timer = new QTimer(this);
+    frame_timer->setTimerType(Qt::PreciseTimer);
+    frame_timer->setInterval(ANIMATION_INTERVAL);
+    connect(frame_timer, &QTimer::timeout, this, &ButtonAnimationDriver::tick);
+}
+
+/**
+ * 程序退出时（QApplication 析构）一起销毁
+ * 之后仍然存在的按钮不再访问驱动器
+ */
+ButtonAnimationDriver::~ButtonAnimationDriver()
+{
+    foreach (AnimationTarget* target, targets)
+    {
+        if (target)
+            target->animation_registered = target->animation_queued = false;
+    }
+    if (driver == this)
+        driver = nullptr;
+}
+
+/**
+ * 获取全局唯一的驱动器
+ * 第一次使用时创建，挂在 QCoreApplication 下面
+ */
+ButtonAnimationDriver *ButtonAnimationDriver::instance()
+{
+    if (driver == nullptr)
+        driver = new ButtonAnimationDriver(QCoreApplication::instance());
+    return driver;
+}
+
+bool ButtonAnimationDriver::hasInstance()
+{
+    return driver != nullptr;
+}
+
+/**
+ * 开始动画：加入刷新队列
+ * 重复注册无影响
+ */
+void ButtonAnimationDriver::registerTarget(AnimationTarget *target)
+{
+    if (target->animation_registered)
+        return ;
+    target->animation_registered = true;
+    active_count++;
+    if (!target->animation_queued) // 刚注销还没来得及移出的，直接复用
+    {
+        target->animation_queued = true;
+        targets.append(target);
+    }
+    if (!frame_timer->isActive() && !clock) // 注入时钟时由外部调用 tick()
+    {
+        updateFrameInterval(); // 屏幕可能变化了，每次开始动画时重新计算
+        frame_timer->start();
+    }
+}
+
+/**
+ * 动画结束：下一帧时移出刷新队列
+ * 可以在 animationTick() 中调用
+ */
+void ButtonAnimationDriver::unregisterTarget(AnimationTarget *target)
+{
+    if (!target->animation_registered)
+        return ;
+    target->animation_registered = false;
+    active_count--;
+}
+
+bool ButtonAnimationDriver::isRegistered(AnimationTarget *target) const
+{
+    return target->animation_registered;
+}
+
+/**
+ * 正在动画的对象数量
+ */
+int ButtonAnimationDriver::getActiveCount() const
+{
+    return active_count;
+}
+
+/**
+ * 设置固定的刷新间隔
+ * 同时切换到 FixedInterval 策略
+ * @param ms 间隔（毫秒）
+ */
+void ButtonAnimationDriver::setInterval(int ms)
+{
+    fixed_interval = ms;
+    frame_policy = FixedInterval;
+    updateFrameInterval();
+}
+
+/**
+ * 当前实际的刷新间隔
+ * @return 间隔（毫秒）
+ */
+int ButtonAnimationDriver::getInterval() const
+{
+    return frame_timer->interval();
+}
+
+/**
+ * 设置刷新率策略
+ * @param policy 固定间隔 / 跟随屏幕刷新率
+ */
+void ButtonAnimationDriver::setFrameRatePolicy(ButtonAnimationDriver::FrameRatePolicy policy)
+{
+    frame_policy = policy;
+    updateFrameInterval();
+}
+
+ButtonAnimationDriver::FrameRatePolicy ButtonAnimationDriver::getFrameRatePolicy() const
+{
+    return frame_policy;
+}
+
+/**
+ * 设置全局帧率上限
+ * 适用于省电模式、远程桌面等绘制代价高的情况
+ * @param fps 每秒最多帧数，0 为不限制
+ */
+void ButtonAnimationDriver::setMaxFrameRate(int fps)
+{
+    max_frame_rate = qMax(0, fps);
+    updateFrameInterval();
+}
+
+int ButtonAnimationDriver::getMaxFrameRate() const
+{
+    return max_frame_rate;
+}
+
+/**
+ * 设置是否自动跳帧
+ * 上一帧（刷新+绘制）耗时超过预算时，跳过接下来的若干帧
+ * 动画进度根据时间戳计算，跳帧不影响动画时长
+ * @param enable 开关
+ */
+void ButtonAnimationDriver::setFrameSkipping(bool enable)
+{
+    frame_skipping = enable;
+    skip_frames = 0;
+}
+
+bool ButtonAnimationDriver::getFrameSkipping() const
+{
+    return frame_skipping;
+}
+
+/**
+ * 按钮绘制完成后汇报耗时
+ * 计入下一帧的跳帧判断
+ * @param nsecs 绘制耗时（纳秒）
+ */
+void ButtonAnimationDriver::reportPaintCost(qint64 nsecs)
+{
+    paint_cost_nsecs += nsecs;
+}
+
+/**
+ * 根据策略计算定时器的间隔
+ * 跟随屏幕时，以所有屏幕中最高的刷新率为准，低刷新率屏幕上的对象会隔帧刷新
+ */
+void ButtonAnimationDriver::updateFrameInterval()
+{
+    int interval = fixed_interval;
+    if (frame_policy == FollowScreen)
+    {
+        qreal max_rate = 0;
+        foreach (QScreen* screen, QGuiApplication::screens())
+            max_rate = qMax(max_rate, screen->refreshRate());
+        if (max_rate > 0)
+            interval = qMax(1, static_cast<int>(1000 / max_rate));
+    }
+    if (max_frame_rate > 0)
+        interval = qMax(interval, 1000 / max_frame_rate);
+    frame_timer->setInterval(interval);
+}
+
+/**
+ * 获取某个对象的刷新间隔
+ * 跟随屏幕时使用它所在屏幕的刷新率，并受全局帧率上限限制
+ * @param  target 动画对象
+ * @return        刷新间隔（纳秒）
+ */
+qint64 ButtonAnimationDriver::getTargetInterval(AnimationTarget *target) const
+{
+    qint64 interval = 0;
+    if (frame_policy == FollowScreen)
+    {
+        QScreen* screen = target->animationScreen();
+        if (screen && screen->refreshRate() > 0)
+            interval = static_cast<qint64>(1000000000 / screen->refreshRate());
+    }
+    if (max_frame_rate > 0)
+        interval = qMax(interval, 1000000000LL / max_frame_rate);
+    return interval;
+}
+
+/**
+ * 替换动画时钟
+ * 注入时钟后驱动器不再自动刷新，也不跳帧，由外部步进时钟后调用 tick()
+ * 每次 tick() 刷新所有正在动画的对象（不按屏幕刷新率隔帧），结果可以完全复现
+ * @param clock 时钟，不转移所有权；nullptr 恢复系统单调时钟
+ */
+void ButtonAnimationDriver::setClock(ButtonAnimationClock *clock)
+{
+    this->clock = clock;
+    skip_frames = 0;
+    paint_cost_nsecs = 0;
+    if (clock)
+    {
+        frame_timer->stop();
+    }
+    else if (!targets.isEmpty() && !frame_timer->isActive())
+    {
+        updateFrameInterval();
+        frame_timer->start();
+    }
+}
+
+ButtonAnimationClock *ButtonAnimationDriver::getClock() const
+{
+    return clock;
+}
+
+/**
+ * 获取动画时间戳（毫秒）
+ * 刷新过程中返回本帧开始的时间，其余时候返回当前时间
+ * @return 单调递增的时间戳
+ */
+qint64 ButtonAnimationDriver::timestamp() const
+{
+    return nsecsTimestamp() / 1000000;
+}
+
+/**
+ * 获取精确到纳秒的动画时间戳
+ * 适用于高刷新率屏幕上更平滑的动画进度
+ * @return 单调递增的时间戳（纳秒）
+ */
+qint64 ButtonAnimationDriver::nsecsTimestamp() const
+{
+    if (ticking)
+        return frame_nsecs;
+    return clock ? clock->nsecsTimestamp() : currentNsecsTimestamp();
+}
+
+/**
+ * 获取鼠标的全局坐标
+ * 动画过程中每帧只查询一次，所有按钮共用（QCursor::pos() 在 X11 等平台上需要和窗口系统通信）
+ * 没有动画时直接查询
+ * @return 鼠标全局坐标
+ */
+QPoint ButtonAnimationDriver::cursorPos()
+{
+    if (!frame_timer->isActive() && !clock)
+        return QCursor::pos();
+    if (cursor_frame != frame_index)
+    {
+        frame_cursor_pos = QCursor::pos();
+        cursor_frame = frame_index;
+    }
+    return frame_cursor_pos;
+}
+
+/**
+ * 获取当前的单调时钟（纳秒）
+ * 基于系统开机以来的单调时钟，不受系统时间调整（例如 NTP 校时）的影响
+ * @return 当前时间戳（纳秒）
+ */
+qint64 ButtonAnimationDriver::currentNsecsTimestamp()
+{
+    static QElapsedTimer clock;
+    static qint64 reference = 0;
+    if (!clock.isValid())
+    {
+        clock.start();
+        reference = clock.msecsSinceReference() * 1000000;
+    }
+    return reference + clock.nsecsElapsed();
+}
+
+/**
+ * 一帧：依次刷新所有正在动画的对象
+ * 刷新过程中新注册的对象也会在本帧刷新
+ */
+void ButtonAnimationDriver::tick()
+{
+    // 上一帧超出预算，跳过本帧（动画按时间戳计算，不会变慢）
+    if (skip_frames > 0)
+    {
+        skip_frames--;
+        paint_cost_nsecs = 0;
+        return ;
+    }
+
+    frame_index++;
+    qint64 start_nsecs = currentNsecsTimestamp(); // 耗时始终按真实时间统计
+    frame_nsecs = clock ? clock->nsecsTimestamp() : start_nsecs;
+    qint64 tolerance = frame_timer->interval() * 1000000LL / 2; // 定时器误差，避免低刷新率屏幕上再隔一帧
+    ticking = true;
+    for (int i = 0; i < targets.size(); i++)
+    {
+        AnimationTarget* target = targets.at(i);
+        if (!target || !target->animation_registered)
+            continue;
+        if (!clock && target->last_tick_nsecs && frame_nsecs - target->last_tick_nsecs < getTargetInterval(target) - tolerance)
+            continue; // 所在屏幕刷新率较低，还没到下一帧
+        target->last_tick_nsecs = frame_nsecs;
+        target->animationTick();
+    }
+    ticking = false;
+
+    // 本帧耗时（刷新 + 上一帧之后的绘制）
+    frame_cost_nsecs = currentNsecsTimestamp() - start_nsecs + paint_cost_nsecs;
+    paint_cost_nsecs = 0;
+    qint64 budget = frame_timer->interval() * 1000000LL;
+    if (frame_skipping && !clock && budget > 0 && frame_cost_nsecs > budget)
+        skip_frames = qMin(static_cast<int>(frame_cost_nsecs / budget), MAX_SKIP_FRAMES);
+
+    // 移出已经注销、已经析构的对象
+    int alive = 0;
+    for (int i = 0; i < targets.size(); i++)
+    {
+        AnimationTarget* target = targets.at(i);
+        if (!target)
+            continue;
+        if (!target->animation_registered)
+        {
+            target->animation_queued = false;
+            target->last_tick_nsecs = 0;
+            continue;
+        }
+        targets[alive++] = target;
+    }
+    targets.erase(targets.begin() + alive, targets.end());
+
+    if (targets.isEmpty()) // 没有需要动画的对象，暂停（节约资源）
+        frame_timer->stop();
+}
+
+/**
+ * 对象析构时调用
+ * 刷新过程中不能改变队列长度，只置空
+ */
+void ButtonAnimationDriver::removeTarget(AnimationTarget *target)
+{
+    if (target->animation_registered)
+        active_count--;
+    target->animation_registered = target->animation_queued = false;
+
+    int index = targets.indexOf(target);
+    if (index == -1)
+        return ;
+    if (ticking)
+        targets[index] = nullptr;
+    else
+        targets.removeAt(index);
+}
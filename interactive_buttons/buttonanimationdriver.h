@@ -0,0 +1,163 @@
+#ifndef BUTTONANIMATIONDRIVER_H
+#define BUTTONANIMATIONDRIVER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QList>
+#include <QElapsedTimer>
+#include <QScreen>
+#include <QPoint>
+
+#define ANIMATION_INTERVAL 10 // 默认动画刷新间隔（毫秒）
+#define MAX_SKIP_FRAMES 3     // 绘制超时后最多连续跳过的帧数
+
+class ButtonAnimationDriver;
+
+/**
+ * 动画时钟
+ * 默认使用系统单调时钟；测试、性能测试、录制回放时可以替换为手动步进的时钟
+ */
+class ButtonAnimationClock
+{
+public:
+    virtual ~ButtonAnimationClock() {}
+    virtual qint64 nsecsTimestamp() const = 0; // 当前时间戳（纳秒），必须单调递增
+};
+
+/**
+ * 手动步进的时钟
+ * 时间只在 advance / setTimestamp 时变化
+ * 同样的鼠标操作序列、同样的步进，得到完全一致的动画进度和绘制结果
+ */
+class ManualAnimationClock : public ButtonAnimationClock
+{
+public:
+    ManualAnimationClock(qint64 start_ms = 1000) : nsecs(start_ms * 1000000) {} // 从非 0 开始，0 表示“没有时间戳”
+    qint64 nsecsTimestamp() const override { return nsecs; }
+
+    void setTimestamp(qint64 ms) { nsecs = ms * 1000000; }
+    void advance(qint64 ms) { nsecs += ms * 1000000; }
+    void advanceNsecs(qint64 delta) { nsecs += delta; }
+
+private:
+    qint64 nsecs;
+};
+
+/**
+ * 由全局动画驱动器统一刷新的对象
+ * 有动画时注册到驱动器，动画结束后注销
+ */
+class AnimationTarget
+{
+    friend class ButtonAnimationDriver;
+public:
+    AnimationTarget() : animation_registered(false), animation_queued(false), last_tick_nsecs(0) {}
+    virtual ~AnimationTarget();
+
+    virtual void animationTick() = 0;
+    virtual QScreen* animationScreen() { return nullptr; } // 所在屏幕，用来匹配屏幕刷新率
+
+private:
+    bool animation_registered; // 是否需要继续刷新
+    bool animation_queued;     // 是否还在驱动器的队列中（注销后延迟到下一帧才移出）
+    qint64 last_tick_nsecs;    // 上一次刷新的时间戳
+};
+
+/**
+ * 全局动画驱动器
+ * 整个进程只有一个定时器，每一帧统一刷新所有正在动画的按钮
+ * 没有动画的按钮不占用任何定时器，CPU 开销只和正在动画的数量有关
+ */
+class ButtonAnimationDriver : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * 刷新率策略
+     */
+    enum FrameRatePolicy
+    {
+        FixedInterval, // 固定间隔（setInterval）
+        FollowScreen   // 跟随屏幕刷新率，每个对象按自己所在屏幕的刷新率刷新
+    };
+
+    static ButtonAnimationDriver* instance();
+    static bool hasInstance();
+    ~ButtonAnimationDriver() override;
+
+    void registerTarget(AnimationTarget* target);
+    void unregisterTarget(AnimationTarget* target);
+    bool isRegistered(AnimationTarget* target) const;
+    int getActiveCount() const;
+
+    void setInterval(int ms);
+    int getInterval() const;
+    void setFrameRatePolicy(FrameRatePolicy policy);
+    FrameRatePolicy getFrameRatePolicy() const;
+    void setMaxFrameRate(int fps);
+    int getMaxFrameRate() const;
+    void setFrameSkipping(bool enable = true);
+    bool getFrameSkipping() const;
+    void reportPaintCost(qint64 nsecs);
+
+    void setClock(ButtonAnimationClock* clock);
+    ButtonAnimationClock* getClock() const;
+    qint64 timestamp() const;
+    qint64 nsecsTimestamp() const;
+    QPoint cursorPos();
+    static qint64 currentNsecsTimestamp();
+
+public slots:
+    void tick();
+
+private:
+    ButtonAnimationDriver(QObject* parent = nullptr);
+    void removeTarget(AnimationTarget* target);
+    void updateFrameInterval();
+    qint64 getTargetInterval(AnimationTarget* target) const;
+
+private:
+    QTimer* frame_timer;
+    QList<AnimationTarget*> targets; // 可能包含已注销（下一帧移出）或已析构（置空）的对象
+    int active_count;
+    bool ticking;
+    qint64 frame_nsecs; // 本帧开始的时间戳，同一帧内所有对象共用
+    int frame_index;          // 帧序号
+    int cursor_frame;         // 鼠标位置采样时的帧序号
+    QPoint frame_cursor_pos;  // 本帧的鼠标位置，同一帧内所有对象共用
+
+    // 刷新率
+    FrameRatePolicy frame_policy;
+    int fixed_interval;       // FixedInterval 策略的刷新间隔
+    int max_frame_rate;       // 全局帧率上限（例如远程桌面、省电模式），0 为不限制
+    bool frame_skipping;      // 上一帧耗时超过预算时自动跳帧
+    qint64 paint_cost_nsecs;  // 上一帧之后所有按钮绘制的耗时
+    qint64 frame_cost_nsecs;  // 上一帧（刷新+绘制）的总耗时
+    int skip_frames;          // 还需要跳过的帧数
+
+    ButtonAnimationClock* clock; // 外部注入的时钟（不负责释放），nullptr 为系统单调时钟
+
+    static ButtonAnimationDriver* driver;
+
+    friend class AnimationTarget;
+};
+
+/**
+ * 统计一次绘制的耗时
+ * 在 paintEvent 开头创建，析构时汇报给动画驱动器
+ */
+class PaintCostReporter
+{
+public:
+    PaintCostReporter() : start_nsecs(ButtonAnimationDriver::currentNsecsTimestamp()) {}
+    ~PaintCostReporter()
+    {
+        if (ButtonAnimationDriver::hasInstance())
+            ButtonAnimationDriver::instance()->reportPaintCost(ButtonAnimationDriver::currentNsecsTimestamp() - start_nsecs);
+    }
+
+private:
+    qint64 start_nsecs;
+};
+
+#endif // BUTTONANIMATIONDRIVER_H
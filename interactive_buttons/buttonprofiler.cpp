@@ -0,0 +1,156 @@
+#include "buttonprofiler.h"
+#include <QCoreApplication>
+
+ButtonProfiler::ButtonProfiler(QObject *parent) : QObject(parent)
+{
+    dump_timer = new QTimer(this);
+    connect(dump_timer, &QTimer::timeout, this, &ButtonProfiler::dump);
+}
+
+/**
+ * 获取全局唯一的统计对象
+ */
+ButtonProfiler *ButtonProfiler::instance()
+{
+    static ButtonProfiler* profiler = nullptr;
+    if (profiler == nullptr)
+        profiler = new ButtonProfiler(QCoreApplication::instance());
+    return profiler;
+}
+
+/**
+ * 是否编译了统计代码
+ * @return 是否定义了 INTERACTIVE_BUTTONS_PROFILING
+ */
+bool ButtonProfiler::isEnabled()
+{
+#ifdef INTERACTIVE_BUTTONS_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * 绘制耗时直方图每个区间的上限
+ * 最后一个区间没有上限
+ * @param  bucket 区间索引
+ * @return        上限（微秒），-1 表示无上限
+ */
+int ButtonProfiler::getHistogramBound(int bucket)
+{
+    static const int bounds[PAINT_HISTOGRAM_BUCKETS] = { 50, 100, 250, 500, 1000, 2000, 4000, 8000, 16000, -1 };
+    if (bucket < 0 || bucket >= PAINT_HISTOGRAM_BUCKETS)
+        return -1;
+    return bounds[bucket];
+}
+
+/**
+ * 记录一次耗时
+ * @param class_name 按钮类名
+ * @param type       记录类型
+ * @param nsecs      耗时（纳秒）
+ */
+void ButtonProfiler::record(const char *class_name, ButtonProfiler::RecordType type, qint64 nsecs)
+{
+    ClassStats& s = stats[QString::fromLatin1(class_name)];
+    switch (type)
+    {
+    case Tick:
+        s.tick_count++;
+        s.tick_nsecs += nsecs;
+        break;
+    case Paint:
+    {
+        s.paint_count++;
+        s.paint_nsecs += nsecs;
+        if (nsecs > s.paint_max_nsecs)
+            s.paint_max_nsecs = nsecs;
+        int bucket = 0;
+        qint64 usecs = nsecs / 1000;
+        while (bucket < PAINT_HISTOGRAM_BUCKETS - 1 && usecs >= getHistogramBound(bucket))
+            bucket++;
+        s.paint_histogram[bucket]++;
+        break;
+    }
+    case PathBuild:
+        s.path_build_count++;
+        s.path_build_nsecs += nsecs;
+        break;
+    }
+}
+
+/**
+ * 所有按钮类的统计数据
+ */
+QHash<QString, ButtonProfiler::ClassStats> ButtonProfiler::getStats() const
+{
+    return stats;
+}
+
+/**
+ * 某一个按钮类的统计数据
+ * @param class_name 类名，例如 "ThreeDimenButton"
+ */
+ButtonProfiler::ClassStats ButtonProfiler::getStats(const QString &class_name) const
+{
+    return stats.value(class_name);
+}
+
+/**
+ * 当前正在动画的对象数量
+ */
+int ButtonProfiler::getActiveAnimationCount() const
+{
+    if (!ButtonAnimationDriver::hasInstance())
+        return 0;
+    return ButtonAnimationDriver::instance()->getActiveCount();
+}
+
+/**
+ * 清空统计数据
+ */
+void ButtonProfiler::reset()
+{
+    stats.clear();
+}
+
+/**
+ * 定时通过 qDebug 输出统计数据
+ * @param ms 间隔（毫秒），0 为关闭
+ */
+void ButtonProfiler::setDumpInterval(int ms)
+{
+    if (ms <= 0)
+    {
+        dump_timer->stop();
+        return ;
+    }
+    dump_timer->start(ms);
+}
+
+/**
+ * 通过 qDebug 输出统计数据
+ */
+void ButtonProfiler::dump() const
+{
+    qDebug() << "InteractiveButtons profile: active animations" << getActiveAnimationCount();
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it)
+    {
+        const ClassStats& s = it.value();
+        QString histogram;
+        for (int i = 0; i < PAINT_HISTOGRAM_BUCKETS; i++)
+        {
+            int bound = getHistogramBound(i);
+            histogram += QString(" %1%2:%3").arg(bound < 0 ? ">=" : "<")
+                    .arg(bound < 0 ? getHistogramBound(i-1) : bound).arg(s.paint_histogram[i]);
+        }
+        qDebug().noquote() << QString("  %1: tick %2 (avg %3us), paint %4 (avg %5us, max %6us), path %7 (avg %8us), paint histogram(us)%9")
+                              .arg(it.key())
+                              .arg(s.tick_count).arg(s.tick_count ? s.tick_nsecs / s.tick_count / 1000.0 : 0, 0, 'f', 1)
+                              .arg(s.paint_count).arg(s.paint_count ? s.paint_nsecs / s.paint_count / 1000.0 : 0, 0, 'f', 1)
+                              .arg(s.paint_max_nsecs / 1000)
+                              .arg(s.path_build_count).arg(s.path_build_count ? s.path_build_nsecs / s.path_build_count / 1000.0 : 0, 0, 'f', 1)
+                              .arg(histogram);
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef BUTTONPROFILER_H
+#define BUTTONPROFILER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QString>
+#include <QDebug>
+#include "buttonanimationdriver.h"
+
+#define PAINT_HISTOGRAM_BUCKETS 10 // 绘制耗时直方图的区间数量
+
+/**
+ * 按钮动画性能统计
+ * 按类名统计每帧刷新、绘制、背景路径计算的次数和耗时，以及正在动画的按钮数量
+ *
+ * 编译开关：在 .pro 中添加 DEFINES += INTERACTIVE_BUTTONS_PROFILING
+ * 未开启时统计代码全部编译为空，接口依旧可用（数据为空）
+ */
+class ButtonProfiler : public QObject
+{
+    Q_OBJECT
+public:
+    enum RecordType
+    {
+        Tick,     // anchorTimeOut 一帧
+        Paint,    // 一次完整的绘制（包括子类）
+        PathBuild // 背景路径重新计算
+    };
+
+    /**
+     * 单个按钮类的统计数据
+     */
+    struct ClassStats
+    {
+        ClassStats() : tick_count(0), paint_count(0), path_build_count(0),
+                       tick_nsecs(0), paint_nsecs(0), path_build_nsecs(0), paint_max_nsecs(0)
+        {
+            for (int i = 0; i < PAINT_HISTOGRAM_BUCKETS; i++)
+                paint_histogram[i] = 0;
+        }
+        qint64 tick_count, paint_count, path_build_count;   // 次数
+        qint64 tick_nsecs, paint_nsecs, path_build_nsecs;   // 累计耗时（纳秒）
+        qint64 paint_max_nsecs;                             // 最慢的一次绘制
+        qint64 paint_histogram[PAINT_HISTOGRAM_BUCKETS];    // 绘制耗时分布，区间见 getHistogramBound
+    };
+
+    static ButtonProfiler* instance();
+    static bool isEnabled();
+    static int getHistogramBound(int bucket);
+
+    void record(const char* class_name, RecordType type, qint64 nsecs);
+    QHash<QString, ClassStats> getStats() const;
+    ClassStats getStats(const QString& class_name) const;
+    int getActiveAnimationCount() const;
+    void reset();
+
+    void setDumpInterval(int ms);
+    void dump() const;
+
+private:
+    ButtonProfiler(QObject* parent = nullptr);
+
+private:
+    QHash<QString, ClassStats> stats;
+    QTimer* dump_timer;
+};
+
+/**
+ * 统计一段代码的耗时，析构时记录
+ */
+class ButtonProfileScope
+{
+public:
+    ButtonProfileScope(const char* name, ButtonProfiler::RecordType type)
+        : class_name(name), record_type(type), start_nsecs(ButtonAnimationDriver::currentNsecsTimestamp()) {}
+    ~ButtonProfileScope()
+    {
+        ButtonProfiler::instance()->record(class_name, record_type,
+                                           ButtonAnimationDriver::currentNsecsTimestamp() - start_nsecs);
+    }
+
+private:
+    const char* class_name;
+    ButtonProfiler::RecordType record_type;
+    qint64 start_nsecs;
+};
+
+#ifdef INTERACTIVE_BUTTONS_PROFILING
+#define BUTTON_PROFILE_SCOPE(type) ButtonProfileScope _button_profile_scope(metaObject()->className(), ButtonProfiler::type)
+#else
+#define BUTTON_PROFILE_SCOPE(type)
+#endif
+
+#endif // BUTTONPROFILER_H
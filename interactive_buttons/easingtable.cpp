@@ -0,0 +1,115 @@
+#include "easingtable.h"
+#include <QtMath>
+
+EasingTable::EasingTable() : EasingTable([](double t) { return t; })
+{
+}
+
+/**
+ * 采样任意曲线
+ * @param curve 输入 [0, 1] 的时间比例，输出进度比例（可以超出 [0, 1]，例如回弹）
+ */
+EasingTable::EasingTable(const std::function<double(double)>& curve)
+{
+    samples.resize(RESOLUTION + 1);
+    for (int i = 0; i <= RESOLUTION; i++)
+        samples[i] = static_cast<float>(curve(static_cast<double>(i) / RESOLUTION));
+}
+
+/**
+ * 三次贝塞尔曲线，与 CSS 的 cubic-bezier(x1, y1, x2, y2) 相同
+ * 起点 (0, 0)、终点 (1, 1)，x1、x2 应在 [0, 1] 内
+ */
+EasingTable EasingTable::cubicBezier(double x1, double y1, double x2, double y2)
+{
+    // B(s) = 3(1-s)^2 s P1 + 3(1-s) s^2 P2 + s^3，展开成多项式系数
+    const double cx = 3 * x1, bx = 3 * (x2 - x1) - cx, ax = 1 - cx - bx;
+    const double cy = 3 * y1, by = 3 * (y2 - y1) - cy, ay = 1 - cy - by;
+    auto bezier_x = [=](double s) { return ((ax * s + bx) * s + cx) * s; };
+    auto bezier_y = [=](double s) { return ((ay * s + by) * s + cy) * s; };
+    auto bezier_dx = [=](double s) { return (3 * ax * s + 2 * bx) * s + cx; };
+
+    return EasingTable([=](double x) {
+        // 牛顿迭代求 x(s) = x 的参数 s
+        double s = x;
+        for (int i = 0; i < 8; i++)
+        {
+            double err = bezier_x(s) - x;
+            if (qAbs(err) < 1e-7)
+                return bezier_y(s);
+            double d = bezier_dx(s);
+            if (qAbs(d) < 1e-6)
+                break;
+            s -= err / d;
+        }
+        // 斜率太小时退回二分法
+        double lo = 0, hi = 1;
+        s = x;
+        for (int i = 0; i < 32; i++)
+        {
+            double v = bezier_x(s);
+            if (qAbs(v - x) < 1e-7)
+                break;
+            if (v < x)
+                lo = s;
+            else
+                hi = s;
+            s = (lo + hi) / 2;
+        }
+        return bezier_y(s);
+    });
+}
+
+/**
+ * 阻尼弹簧，从 0 运动到 1，在终点附近来回振动后停下
+ * 残余的偏差按时间比例线性修正，保证结束时正好为 1
+ * @param damping   阻尼比，小于 1 会振动，越小振动越多；大于等于 1 不振动
+ * @param frequency 整个动画时长内的固有振动次数
+ */
+EasingTable EasingTable::spring(double damping, double frequency)
+{
+    const double omega = 2 * M_PI * qMax(frequency, 0.01);
+    const double zeta = qMax(damping, 0.0);
+    auto curve = [=](double t) {
+        if (zeta < 1)
+        {
+            double omega_d = omega * qSqrt(1 - zeta * zeta);
+            return 1 - qExp(-zeta * omega * t) * (qCos(omega_d * t) + zeta * omega / omega_d * qSin(omega_d * t));
+        }
+        return 1 - qExp(-omega * t) * (1 + omega * t); // 临界阻尼（过阻尼按临界处理）
+    };
+    const double residual = 1 - curve(1.0);
+    return EasingTable([=](double t) { return curve(t) + residual * t; });
+}
+
+/**
+ * 批量查表
+ * 没有分支依赖、没有函数调用，编译器可以自动向量化
+ * @param t     时间比例数组
+ * @param out   输出的进度比例数组
+ * @param count 数量
+ */
+void EasingTable::evaluate(const float *t, float *out, int count) const
+{
+    const float* table = samples.constData();
+    for (int i = 0; i < count; i++)
+    {
+        float pos = qBound(0.0f, t[i], 1.0f) * RESOLUTION;
+        int index = qMin(static_cast<int>(pos), static_cast<int>(RESOLUTION) - 1);
+        float frac = pos - index;
+        out[i] = table[index] + (table[index + 1] - table[index]) * frac;
+    }
+}
+
+/**
+ * 批量按百分比进度查表
+ * @param progress 进度数组（0~100）
+ * @param out      输出的进度比例数组
+ * @param count    数量
+ */
+void EasingTable::evaluate(const int *progress, float *out, int count) const
+{
+    const float* table = samples.constData();
+    for (int i = 0; i < count; i++)
+        out[i] = table[qBound(0, progress[i], 100) * (RESOLUTION / 100)];
+}
@@ -0,0 +1,64 @@
+#ifndef EASINGTABLE_H
+#define EASINGTABLE_H
+
+#include <QVector>
+#include <functional>
+
+/**
+ * 预先计算好的缓动曲线
+ * 把 [0, 1] 分成 RESOLUTION 份采样，取值时查表 + 线性插值，不再每次计算开方、三角函数
+ * RESOLUTION 是 100 的整数倍，整数百分比进度直接命中采样点，不需要插值
+ * 贝塞尔、弹簧等带参数的曲线也用同样的方式生成，取值开销与线性曲线相同
+ * 采样数据隐式共享，复制（例如存进按钮样式）只增加引用计数
+ */
+class EasingTable
+{
+public:
+    enum { RESOLUTION = 1000 };
+
+    EasingTable(); // 线性
+    explicit EasingTable(const std::function<double(double)>& curve);
+
+    static EasingTable cubicBezier(double x1, double y1, double x2, double y2);
+    static EasingTable spring(double damping, double frequency);
+
+    double value(double t) const;
+    double valueAt(int progress) const;
+    bool operator==(const EasingTable& other) const { return samples == other.samples; }
+    bool operator!=(const EasingTable& other) const { return !(*this == other); }
+
+    void evaluate(const float* t, float* out, int count) const;
+    void evaluate(const int* progress, float* out, int count) const;
+
+private:
+    QVector<float> samples; // RESOLUTION + 1 个采样点
+};
+
+/**
+ * 查表，t 超出 [0, 1] 时取端点
+ */
+inline double EasingTable::value(double t) const
+{
+    if (t <= 0)
+        return samples.at(0);
+    if (t >= 1)
+        return samples.at(RESOLUTION);
+    double pos = t * RESOLUTION;
+    int i = qMin(static_cast<int>(pos), static_cast<int>(RESOLUTION) - 1);
+    double frac = pos - i;
+    return samples.at(i) + (samples.at(i + 1) - samples.at(i)) * frac;
+}
+
+/**
+ * 按百分比进度查表（0~100），直接对应采样点
+ */
+inline double EasingTable::valueAt(int progress) const
+{
+    if (progress <= 0)
+        return samples.at(0);
+    if (progress >= 100)
+        return samples.at(RESOLUTION);
+    return samples.at(progress * (RESOLUTION / 100));
+}
+
+#endif // EASINGTABLE_H
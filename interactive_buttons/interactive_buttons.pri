@@ -0,0 +1,65 @@
+# 可交互按钮模块
+# 使用方法一：直接编译源码，在 .pro 中 include(interactive_buttons/interactive_buttons.pri)
+# 使用方法二：链接 interactive_buttons.pro 编译出的静态库（需在同一个 subdirs 工程中先编译它）
+#     CONFIG += interactive_buttons_link
+#     include(interactive_buttons/interactive_buttons.pri)
+
+# 开启按钮动画性能统计（每个按钮类的刷新/绘制耗时，见 ButtonProfiler）
+#DEFINES += INTERACTIVE_BUTTONS_PROFILING
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+interactive_buttons_link {
+    IB_LIB_DIR = $$shadowed($$PWD)
+    win32:CONFIG(release, debug|release): IB_LIB_DIR = $$IB_LIB_DIR/release
+    else:win32:CONFIG(debug, debug|release): IB_LIB_DIR = $$IB_LIB_DIR/debug
+
+    LIBS += -L$$IB_LIB_DIR -linteractive_buttons
+
+    win32:!win32-g++: PRE_TARGETDEPS += $$IB_LIB_DIR/interactive_buttons.lib
+    else: PRE_TARGETDEPS += $$IB_LIB_DIR/libinteractive_buttons.a
+} else {
+    SOURCES += \
+        $$PWD/buttonanimationdriver.cpp \
+        $$PWD/buttonprofiler.cpp \
+        $$PWD/easingtable.cpp \
+        $$PWD/generalbuttoninterface.cpp \
+        $$PWD/interactivebuttonbase.cpp \
+        $$PWD/interactivebuttonitemgroup.cpp \
+        $$PWD/interactivebuttonstyle.cpp \
+        $$PWD/pointmenubutton.cpp \
+        $$PWD/threedimenbutton.cpp \
+        $$PWD/waterfallbuttongroup.cpp \
+        $$PWD/waterzoombutton.cpp \
+        $$PWD/winminbutton.cpp \
+        $$PWD/winmaxbutton.cpp \
+        $$PWD/winrestorebutton.cpp \
+        $$PWD/winclosebutton.cpp \
+        $$PWD/winmenubutton.cpp \
+        $$PWD/winsidebarbutton.cpp \
+        $$PWD/watercirclebutton.cpp \
+        $$PWD/waterfloatbutton.cpp
+
+    HEADERS += \
+        $$PWD/buttonanimationdriver.h \
+        $$PWD/buttonprofiler.h \
+        $$PWD/easingtable.h \
+        $$PWD/generalbuttoninterface.h \
+        $$PWD/interactivebuttonbase.h \
+        $$PWD/interactivebuttonitemgroup.h \
+        $$PWD/interactivebuttonstyle.h \
+        $$PWD/pointmenubutton.h \
+        $$PWD/ringqueue.h \
+        $$PWD/threedimenbutton.h \
+        $$PWD/waterfallbuttongroup.h \
+        $$PWD/waterzoombutton.h \
+        $$PWD/winminbutton.h \
+        $$PWD/winmaxbutton.h \
+        $$PWD/winrestorebutton.h \
+        $$PWD/winclosebutton.h \
+        $$PWD/winmenubutton.h \
+        $$PWD/winsidebarbutton.h \
+        $$PWD/watercirclebutton.h \
+        $$PWD/waterfloatbutton.h
+}
@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# 可交互按钮静态库
+# 演示程序、性能测试通过 CONFIG += interactive_buttons_link 链接
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = interactive_buttons
+TEMPLATE = lib
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11 staticlib precompile_header
+
+# 每个按钮类都要经过 interactivebuttonbase.h 引入 QApplication、QPainter 等，预编译一次
+PRECOMPILED_HEADER = interactive_buttons_pch.h
+
+include(interactive_buttons.pri)
@@ -0,0 +1,35 @@
+#ifndef INTERACTIVE_BUTTONS_PCH_H
+#define INTERACTIVE_BUTTONS_PCH_H
+
+/**
+ * 可交互按钮库的预编译头
+ * 只放 Qt 头文件，本模块的头文件改动频繁，不放进来
+ */
+
+#if defined __cplusplus
+#include <QObject>
+#include <QApplication>
+#include <QWidget>
+#include <QPushButton>
+#include <QPoint>
+#include <QTimer>
+#include <QPropertyAnimation>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QBitmap>
+#include <QIcon>
+#include <QStaticText>
+#include <QFontMetrics>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSharedData>
+#include <QList>
+#include <QVector>
+#include <QDebug>
+#include <QtMath>
+#endif
+
+#endif // INTERACTIVE_BUTTONS_PCH_H
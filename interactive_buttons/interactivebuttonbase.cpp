@@ -1,4 +1,9 @@
 #include "interactivebuttonbase.h"
+#include <QWindow>
+#include <QPixmapCache>
+
+// 动画状态要保持在一个缓存行之内
+Q_STATIC_ASSERT(sizeof(InteractiveButtonBase::AnimationState) <= 64);
 
 /**
  * 所有内容的初始化
@@ -6,28 +11,23 @@
  */
 InteractiveButtonBase::InteractiveButtonBase(QWidget *parent)
     : QPushButton(parent), icon(nullptr), text(""), paint_addin(),
-      fore_paddings(4,4,4,4),
       self_enabled(true), parent_enabled(false), fore_enabled(true),
-      show_animation(false), show_foreground(true), show_ani_appearing(false), show_ani_disappearing(false),
-      show_duration(300), show_timestamp(0), hide_timestamp(0), show_ani_progress(0), show_ani_point(0,0),
-      enter_pos(-1, -1), press_pos(-1, -1), release_pos(-1, -1), mouse_pos(-1, -1), anchor_pos(-1,  -1),
-      offset_pos(0, 0), effect_pos(-1, -1), release_offset(0, 0),
+      show_animation(false), show_foreground(true),
+      show_timestamp(0), hide_timestamp(0), show_ani_point(0,0),
+      enter_pos(-1, -1), press_pos(-1, -1), release_pos(-1, -1), mouse_pos(-1, -1), release_offset(0, 0),
       hovering(false), pressing(false),
       hover_timestamp(0), leave_timestamp(0), press_timestamp(0), release_timestamp(0),
-      hover_bg_duration(300), press_bg_duration(300), click_ani_duration(300),
-      move_speed(5),
-      icon_color(0, 0, 0), text_color(0,0,0),
-      normal_bg(0xF2, 0xF2, 0xF2, 0), hover_bg(128, 128, 128, 32), press_bg(128, 128, 128, 64), border_bg(0,0,0,0),
-      focus_bg(0,0,0,0), focus_border(0,0,0,0),
-      hover_speed(5), press_start(40), press_speed(5),
-      hover_progress(0), press_progress(0), icon_padding_proper(0.25), icon_text_padding(4), icon_text_size(16),
-      border_width(1), radius_x(0), radius_y(0),
-      font_size(0), fixed_fore_pos(false), fixed_fore_size(false), text_dynamic_size(false), auto_text_color(true), focusing(false),
-      click_ani_appearing(false), click_ani_disappearing(false), click_ani_progress(0),
+      icon_text_size(16),
+      bg_path_valid(false), bg_path_radius_x(0), bg_path_radius_y(0), bg_path_key(0),
+      font_size(0), paint_font_valid(false), paint_font_revision(0), fore_layer_cache(false), fixed_fore_pos(false), fixed_fore_size(false), text_dynamic_size(false), auto_text_color(true), focusing(false),
       mouse_press_event(nullptr), mouse_release_event(nullptr),
       unified_geometry(false), _l(0), _t(0), _w(32), _h(32),
-      jitter_animation(true), elastic_coefficient(1.2), jitter_duration(300),
-      water_animation(true), water_press_duration(800), water_release_duration(400), water_finish_duration(300),
+      jitter_animation(true),
+      water_animation(true), waters(DEFAULT_WATER_CAPACITY),
+      last_hover_progress(0), last_press_progress(0), last_click_ani_progress(0), last_show_ani_progress(0),
+      last_click_ani_appearing(false), last_click_ani_disappearing(false),
+      last_show_ani_appearing(false), last_show_ani_disappearing(false), last_show_foreground(true),
+      last_offset_pos(0, 0), last_water_finished(false),
       align(Qt::AlignCenter), _state(false), leave_after_clicked(false), _block_hover(false),
       double_clicked(false), double_timer(nullptr), double_prevent(false)
 {
@@ -35,13 +35,9 @@ InteractiveButtonBase::InteractiveButtonBase(QWidget *parent)
 
     model = PaintModel::None;
 
-    anchor_timer = new QTimer(this);
-    anchor_timer->setInterval(10);
-    connect(anchor_timer, SIGNAL(timeout()), this, SLOT(anchorTimeOut()));
-
     setWaterRipple();
 
-    connect(this, SIGNAL(clicked()), this, SLOT(slotClicked()));
+    connect(this, &InteractiveButtonBase::clicked, this, &InteractiveButtonBase::slotClicked);
 
     setFocusPolicy(Qt::NoFocus); // 避免一个按钮还获取Tab键焦点
 }
@@ -123,18 +119,8 @@ void InteractiveButtonBase::setText(QString text)
     // 根据字体调整大小
     if (text_dynamic_size)
     {
-        if (font_size <= 0)
-        {
-            QFontMetrics fm(font());
-            setMinimumSize(fm.horizontalAdvance(text)+fore_paddings.left+fore_paddings.right, fm.lineSpacing()+fore_paddings.top+fore_paddings.bottom);
-        }
-        else
-        {
-            QFont font;
-            font.setPointSize(font_size);
-            QFontMetrics fm(font);
-            setMinimumSize(fm.horizontalAdvance(text)+fore_paddings.left+fore_paddings.right, fm.lineSpacing()+fore_paddings.top+fore_paddings.bottom);
-        }
+        QFontMetrics fm(getPaintFont());
+        setMinimumSize(fm.horizontalAdvance(text)+button_style->fore_paddings.left+button_style->fore_paddings.right, fm.lineSpacing()+button_style->fore_paddings.top+button_style->fore_paddings.bottom);
     }
     update();
 }
@@ -231,9 +217,9 @@ void InteractiveButtonBase::setPixmap(QPixmap pixmap)
         QFontMetrics fm(this->font());
         icon_text_size = fm.lineSpacing();
     }
-    this->pixmap = getMaskPixmap(pixmap, isEnabled()?icon_color:getOpacityColor(icon_color));
+    this->pixmap = pixmap; // 着色延迟到绘制时（共享缓存）
     if (parent_enabled)
-        QPushButton::setIcon(QIcon(pixmap));
+        QPushButton::setIcon(QIcon(getMaskPixmap(pixmap, getIconPaintColor())));
     update();
 }
 
@@ -245,9 +231,6 @@ void InteractiveButtonBase::setPixmap(QPixmap pixmap)
  */
 void InteractiveButtonBase::setPaintAddin(QPixmap pixmap, Qt::Alignment align, QSize size)
 {
-    QBitmap mask = pixmap.mask();
-    pixmap.fill(icon_color);
-    pixmap.setMask(mask);
     paint_addin = PaintAddin(pixmap, align, size);
     update();
 }
@@ -277,7 +260,7 @@ void InteractiveButtonBase::setParentEnabled(bool e)
     if (model == PaintModel::Icon || model == PaintModel::IconText)
         QPushButton::setIcon(icon);
     if (model == PaintModel::PixmapMask || model == PaintModel::PixmapText)
-        QPushButton::setIcon(QIcon(pixmap));
+        QPushButton::setIcon(QIcon(getMaskPixmap(pixmap, getIconPaintColor())));
 }
 
 /**
@@ -292,12 +275,13 @@ void InteractiveButtonBase::setForeEnabled(bool e)
 
 /**
  * 设置鼠标悬浮背景渐变的动画时长
+ * 根据时间戳计算进度，刷新不及时也会准时完成
  * @param d 动画时长（毫秒）
  */
 void InteractiveButtonBase::setHoverAniDuration(int d)
 {
-    this->hover_bg_duration = d;
-//    hover_progress = 0; // 重置hover效果
+    button_style.setHoverAniDuration(d);
+//    ani.hover_progress = 0; // 重置hover效果
 }
 
 /**
@@ -306,7 +290,7 @@ void InteractiveButtonBase::setHoverAniDuration(int d)
  */
 void InteractiveButtonBase::setPressAniDuration(int d)
 {
-    this->press_bg_duration = d;
+    button_style.setPressAniDuration(d);
 }
 
 /**
@@ -315,7 +299,7 @@ void InteractiveButtonBase::setPressAniDuration(int d)
  */
 void InteractiveButtonBase::setClickAniDuration(int d)
 {
-    this->click_ani_duration = d;
+    button_style.setClickAniDuration(d);
 }
 
 /**
@@ -326,34 +310,38 @@ void InteractiveButtonBase::setClickAniDuration(int d)
  */
 void InteractiveButtonBase::setWaterAniDuration(int press, int release, int finish)
 {
-    this->water_press_duration = press;
-    this->water_release_duration = release;
-    this->water_finish_duration = finish;
+    button_style.setWaterAniDuration(press, release, finish);
+}
+
+/**
+ * 设置鼠标悬浮背景渐变的缓动曲线
+ * @param easing 曲线，例如 getEasingTable(SlowFaster)、EasingTable::cubicBezier(...)
+ */
+void InteractiveButtonBase::setHoverEasing(const EasingTable &easing)
+{
+    button_style.setHoverEasing(easing);
+    update();
+}
+
+/**
+ * 设置水波纹扩散的缓动曲线
+ * @param easing 曲线
+ */
+void InteractiveButtonBase::setWaterEasing(const EasingTable &easing)
+{
+    button_style.setWaterEasing(easing);
 }
 
 /**
  * 各种状态改变
- * 主要是监控 可用 状态，不可用时设置为半透明
+ * 不可用时的半透明在绘制时由 getIconPaintColor 计算，这里不需要处理
  */
 void InteractiveButtonBase::changeEvent(QEvent *event)
 {
     QPushButton::changeEvent(event);
 
-    if (event->type() == QEvent::EnabledChange && model == PixmapMask) // 可用状态改变了
-    {
-        if (isEnabled()) // 恢复可用：透明度变回去
-        {
-            QColor color = icon_color;
-            color.setAlpha(color.alpha() * 2);
-            setIconColor(color);
-        }
-        else // 变成不可用：透明度减半
-        {
-            QColor color = icon_color;
-            color.setAlpha(color.alpha() / 2);
-            setIconColor(color);
-        }
-    }
+    if (event->type() == QEvent::FontChange) // 字体改变，重新排版文字
+        paint_font_valid = false;
 }
 
 /**
@@ -367,6 +355,17 @@ void InteractiveButtonBase::setWaterRipple(bool enable)
     water_animation = enable;
 }
 
+/**
+ * 设置同时存在的水波纹数量上限
+ * 快速连续点击时超出上限的最旧的水波纹直接丢弃（已被新的水波纹覆盖）
+ * @param capacity 数量上限，至少为 1
+ */
+void InteractiveButtonBase::setWaterCapacity(int capacity)
+{
+    waters.setCapacity(capacity);
+    update();
+}
+
 /**
  * 设置抖动效果是否开启
  * 鼠标拖拽移动的距离越长，抖动距离越长、次数越多
@@ -418,7 +417,7 @@ void InteractiveButtonBase::setBgColor(QColor hover, QColor press)
  */
 void InteractiveButtonBase::setNormalColor(QColor color)
 {
-    normal_bg = color;
+    button_style.setNormalColor(color);
 }
 
 /**
@@ -427,7 +426,7 @@ void InteractiveButtonBase::setNormalColor(QColor color)
  */
 void InteractiveButtonBase::setBorderColor(QColor color)
 {
-    border_bg = color;
+    button_style.setBorderColor(color);
 }
 
 /**
@@ -436,7 +435,7 @@ void InteractiveButtonBase::setBorderColor(QColor color)
  */
 void InteractiveButtonBase::setHoverColor(QColor color)
 {
-    hover_bg = color;
+    button_style.setHoverColor(color);
 }
 
 /**
@@ -445,7 +444,7 @@ void InteractiveButtonBase::setHoverColor(QColor color)
  */
 void InteractiveButtonBase::setPressColor(QColor color)
 {
-    press_bg = color;
+    button_style.setPressColor(color);
 }
 
 /**
@@ -454,20 +453,9 @@ void InteractiveButtonBase::setPressColor(QColor color)
  */
 void InteractiveButtonBase::setIconColor(QColor color)
 {
-    icon_color = color;
-
-    // 绘制图标（如果有）
-    if (model == PaintModel::PixmapMask || model == PaintModel::PixmapText)
-    {
-        pixmap = getMaskPixmap(pixmap, isEnabled()?icon_color:getOpacityColor(icon_color));
-    }
-
-    // 绘制额外角标（如果有的话）
-    if (paint_addin.enable)
-    {
-        paint_addin.pixmap = getMaskPixmap(paint_addin.pixmap, isEnabled()?icon_color:getOpacityColor(icon_color));
-    }
+    button_style.setIconColor(color);
 
+    // 图标、角标在绘制时按新颜色从缓存获取
     update();
 }
 
@@ -477,7 +465,7 @@ void InteractiveButtonBase::setIconColor(QColor color)
  */
 void InteractiveButtonBase::setTextColor(QColor color)
 {
-    text_color = color;
+    button_style.setTextColor(color);
     update();
 }
 
@@ -488,7 +476,7 @@ void InteractiveButtonBase::setTextColor(QColor color)
 void InteractiveButtonBase::setFocusBg(QColor color)
 {
     setFocusPolicy(Qt::StrongFocus);
-    focus_bg = color;
+    button_style.setFocusBg(color);
 }
 
 /**
@@ -498,7 +486,7 @@ void InteractiveButtonBase::setFocusBg(QColor color)
 void InteractiveButtonBase::setFocusBorder(QColor color)
 {
     setFocusPolicy(Qt::StrongFocus);
-    focus_border = color;
+    button_style.setFocusBorder(color);
 }
 
 /**
@@ -510,6 +498,7 @@ void InteractiveButtonBase::setFontSize(int f)
     if (!font_size) // 第一次设置字体大小，直接设置
     {
         font_size = f;
+        paint_font_valid = false;
         QFont font(this->font());
         font.setPointSize(f);
         setFont(font);
@@ -517,16 +506,16 @@ void InteractiveButtonBase::setFontSize(int f)
     }
     else // 改变字体大小，使用字体缩放动画
     {
-        QPropertyAnimation* ani = new QPropertyAnimation(this, "font_size");
-        ani->setStartValue(font_size);
-        ani->setEndValue(f);
-        ani->setDuration(click_ani_duration);
-        connect(ani, &QPropertyAnimation::finished, [=]{
+        QPropertyAnimation* font_ani = new QPropertyAnimation(this, "font_size");
+        font_ani->setStartValue(font_size);
+        font_ani->setEndValue(f);
+        font_ani->setDuration(button_style->click_ani_duration);
+        connect(font_ani, &QPropertyAnimation::finished, this, [=]{
             QFontMetrics fm(this->font());
             icon_text_size = fm.lineSpacing();
-            ani->deleteLater();
+            font_ani->deleteLater();
         });
-        ani->start();
+        font_ani->start();
     }
     // 修改字体大小时调整按钮的最小尺寸，避免文字显示不全
     if (text_dynamic_size)
@@ -534,7 +523,7 @@ void InteractiveButtonBase::setFontSize(int f)
         QFont font;
         font.setPointSize(f);
         QFontMetrics fms(font);
-        setMinimumSize(fms.horizontalAdvance(text)+fore_paddings.left+fore_paddings.right, fms.lineSpacing()+fore_paddings.top+fore_paddings.bottom);
+        setMinimumSize(fms.horizontalAdvance(text)+button_style->fore_paddings.left+button_style->fore_paddings.right, fms.lineSpacing()+button_style->fore_paddings.top+button_style->fore_paddings.bottom);
     }
     if (model != PaintModel::Text)
     {
@@ -561,6 +550,7 @@ int InteractiveButtonBase::getFontSizeT()
 void InteractiveButtonBase::setFontSizeT(int f)
 {
     this->font_size = f;
+    paint_font_valid = false;
     QFont font(this->font());
     font.setPointSize(f);
     setFont(font);
@@ -593,7 +583,8 @@ void InteractiveButtonBase::setAlign(Qt::Alignment a)
  */
 void InteractiveButtonBase::setRadius(int r)
 {
-    radius_x = radius_y = r;
+    button_style.setRadius(r, r);
+    invalidateBgPainterPath();
 }
 
 /**
@@ -603,8 +594,8 @@ void InteractiveButtonBase::setRadius(int r)
  */
 void InteractiveButtonBase::setRadius(int rx, int ry)
 {
-    radius_x = rx;
-    radius_y = ry;
+    button_style.setRadius(rx, ry);
+    invalidateBgPainterPath();
 }
 
 /**
@@ -613,7 +604,7 @@ void InteractiveButtonBase::setRadius(int rx, int ry)
  */
 void InteractiveButtonBase::setBorderWidth(int x)
 {
-    border_width = x;
+    button_style.setBorderWidth(x);
 }
 
 /**
@@ -633,12 +624,7 @@ void InteractiveButtonBase::setDisabled(bool dis)
         setAttribute(Qt::WA_TransparentForMouseEvents, dis); // 点击穿透
     }
 
-    if (model == PixmapMask || model == PixmapText)
-    {
-        pixmap = getMaskPixmap(pixmap, dis?getOpacityColor(icon_color):icon_color);
-    }
-
-    update(); // 修改透明度
+    update(); // 修改透明度（图标颜色在绘制时根据可用状态计算）
 }
 
 /**
@@ -650,10 +636,7 @@ void InteractiveButtonBase::setDisabled(bool dis)
  */
 void InteractiveButtonBase::setPaddings(int l, int r, int t, int b)
 {
-    fore_paddings.left = l;
-    fore_paddings.right = r;
-    fore_paddings.top = t;
-    fore_paddings.bottom = b;
+    button_style.setPaddings(l, r, t, b);
     setFixedForeSize();
 }
 
@@ -664,8 +647,7 @@ void InteractiveButtonBase::setPaddings(int l, int r, int t, int b)
  */
 void InteractiveButtonBase::setPaddings(int h, int v)
 {
-    fore_paddings.left = fore_paddings.right = (h+1) / 2;
-    fore_paddings.top = fore_paddings.bottom = (v+1) / 2;
+    button_style.setPaddings((h+1) / 2, (h+1) / 2, (v+1) / 2, (v+1) / 2);
     setFixedForeSize();
 }
 
@@ -675,10 +657,7 @@ void InteractiveButtonBase::setPaddings(int h, int v)
  */
 void InteractiveButtonBase::setPaddings(int x)
 {
-    fore_paddings.left = x;
-    fore_paddings.right = x;
-    fore_paddings.top = x;
-    fore_paddings.bottom = x;
+    button_style.setPaddings(x, x, x, x);
     setFixedForeSize();
 }
 
@@ -688,11 +667,7 @@ void InteractiveButtonBase::setPaddings(int x)
  */
 void InteractiveButtonBase::setIconPaddingProper(double x)
 {
-    icon_padding_proper = x;
-    int short_side = min(geometry().width(), geometry().height()); // 短边
-    // 非固定的情况，尺寸大小变了之后所有 padding 都要变
-    int padding = short_side*icon_padding_proper; //static_cast<int>(short_side * (1 - GOLDEN_RATIO) / 2);
-    fore_paddings.left = fore_paddings.top = fore_paddings.right = fore_paddings.bottom = padding;
+    button_style.setIconPaddingProper(x);
     update();
 }
 
@@ -743,8 +718,8 @@ void InteractiveButtonBase::setFixedForeSize(bool f, int addin)
             font.setPointSize(font_size);
         QFontMetrics fm(font);
         setMinimumSize(
-            fm.horizontalAdvance(text)+fore_paddings.left+fore_paddings.right+addin,
-            fm.lineSpacing()+fore_paddings.top+fore_paddings.bottom+addin
+            fm.horizontalAdvance(text)+button_style->fore_paddings.left+button_style->fore_paddings.right+addin,
+            fm.lineSpacing()+button_style->fore_paddings.top+button_style->fore_paddings.bottom+addin
         );
     }
     else if (model == PaintModel::Icon || model == PaintModel::PixmapMask)
@@ -781,15 +756,8 @@ void InteractiveButtonBase::setDoubleClicked(bool e)
 {
     double_clicked = e;
 
-    if (double_timer == nullptr)
-    {
-        double_timer = new QTimer(this);
-        double_timer->setInterval(DOUBLE_PRESS_INTERVAL);
-        connect(double_timer, &QTimer::timeout, [=]{
-            double_timer->stop();
-            emit clicked(); // 手动触发单击事件
-        });
-    }
+    if (!e)
+        stopDoubleTimer();
 }
 
 /**
@@ -823,6 +791,22 @@ void InteractiveButtonBase::setBlockHover(bool b)
         leaveEvent(nullptr);
 }
 
+/**
+ * 整体设置样式（颜色、动画时长、圆角、留白等）
+ * 同一个样式赋给多个按钮时共用一份数据，之后单独修改某个按钮才会复制
+ * @param style 样式
+ */
+void InteractiveButtonBase::setButtonStyle(const InteractiveButtonStyle &style)
+{
+    if (button_style.isSharedWith(style))
+        return ;
+    button_style = style;
+    invalidateBgPainterPath();
+    if (fixed_fore_size)
+        setFixedForeSize();
+    update();
+}
+
 /**
  * 是否开启出现动画
  * 鼠标进入按钮区域，前景图标从对面方向缩放出现
@@ -840,14 +824,14 @@ void InteractiveButtonBase::setShowAni(bool enable)
     {
         if (!hovering && !pressing) // 应该是隐藏状态
         {
-            show_ani_appearing = show_ani_disappearing = show_foreground = false;
-            show_ani_progress = 0;
+            ani.show_ani_appearing = ani.show_ani_disappearing = show_foreground = false;
+            ani.show_ani_progress = 0;
         }
         else // 应该是显示状态
         {
             show_foreground = true;
-            show_ani_appearing = show_ani_disappearing = false;
-            show_ani_progress = 100;
+            ani.show_ani_appearing = ani.show_ani_disappearing = false;
+            ani.show_ani_progress = 100;
         }
     }
 }
@@ -860,11 +844,10 @@ void InteractiveButtonBase::showForeground()
 {
     if (!show_animation) return ;
     waters.clear();
-    if (!anchor_timer->isActive())
-        anchor_timer->start();
-    if (show_ani_disappearing)
-        show_ani_disappearing = false;
-    show_ani_appearing = true;
+    startAnimation();
+    if (ani.show_ani_disappearing)
+        ani.show_ani_disappearing = false;
+    ani.show_ani_appearing = true;
     show_timestamp = getTimestamp();
     show_foreground = true;
     show_ani_point = QPoint(0,0);
@@ -893,11 +876,10 @@ void InteractiveButtonBase::showForeground2(QPoint point)
 void InteractiveButtonBase::hideForeground()
 {
     if (!show_animation) return ;
-    if (!anchor_timer->isActive())
-        anchor_timer->start();
-    if (show_ani_appearing)
-        show_ani_appearing = false;
-    show_ani_disappearing = true;
+    startAnimation();
+    if (ani.show_ani_appearing)
+        ani.show_ani_appearing = false;
+    ani.show_ani_disappearing = true;
     hide_timestamp = getTimestamp();
 }
 
@@ -910,11 +892,14 @@ void InteractiveButtonBase::hideForeground()
 void InteractiveButtonBase::delayShowed(int time, QPoint point)
 {
     setShowAni(true);
-    QTimer::singleShot(time, [=]{
+    QTimer::singleShot(time, this, [=]{
         showForeground2(point);
-        connect(this, &InteractiveButtonBase::showAniFinished, [=]{
+        // 只断开本次的连接，不影响外部连接的 showAniFinished
+        QMetaObject::Connection* connection = new QMetaObject::Connection;
+        *connection = connect(this, &InteractiveButtonBase::showAniFinished, this, [=]{
             setShowAni(false);
-            disconnect(this, SIGNAL(showAniFinished()), nullptr, nullptr);
+            disconnect(*connection);
+            delete connection;
         });
     });
 }
@@ -1023,6 +1008,41 @@ void InteractiveButtonBase::discardHoverPress(bool force)
     }
 }
 
+/**
+ * 立即结束所有交互动画，回到刚创建时的状态
+ * 不模拟鼠标事件、不发出信号，用于按钮被回收复用（例如 WaterFallButtonGroup）
+ */
+void InteractiveButtonBase::resetAnimationState()
+{
+    stopAnimation();
+    stopDoubleTimer();
+    hovering = pressing = false;
+    double_prevent = false;
+    ani = AnimationState();
+    waters.clear();
+    jitters.clear();
+    last_offset_pos = QPoint(0, 0);
+    last_water_finished = false;
+    mouse_pos = QPoint(width()/2, height()/2);
+    ani.anchor_pos = mouse_pos;
+    update();
+}
+
+/**
+ * 统计完整的绘制耗时（包括子类重写的 paintEvent）
+ * 用于动画自动跳帧和性能统计
+ */
+bool InteractiveButtonBase::event(QEvent *event)
+{
+    if (event->type() == QEvent::Paint)
+    {
+        PaintCostReporter cost_reporter;
+        BUTTON_PROFILE_SCOPE(Paint);
+        return QPushButton::event(event);
+    }
+    return QPushButton::event(event);
+}
+
 /**
  * 鼠标移入事件，触发 hover 时间戳
  */
@@ -1035,10 +1055,7 @@ void InteractiveButtonBase::enterEvent(QEvent *event)
         return ;
     }
 
-    if (!anchor_timer->isActive())
-    {
-        anchor_timer->start();
-    }
+    startAnimation();
     hovering = true;
     hover_timestamp = getTimestamp();
     leave_timestamp = 0;
@@ -1055,6 +1072,7 @@ void InteractiveButtonBase::enterEvent(QEvent *event)
 void InteractiveButtonBase::leaveEvent(QEvent *event)
 {
     hovering = false;
+    leave_timestamp = getTimestamp();
     if (!pressing)
         mouse_pos = QPoint(geometry().width()/2, geometry().height()/2);
     emit signalMouseLeave();
@@ -1088,7 +1106,7 @@ void InteractiveButtonBase::mousePressEvent(QMouseEvent *event)
             {
                 double_prevent = true; // 阻止本次的release识别为单击
                 press_timestamp = 0;   // 避免很可能出现的三击、四击...
-                double_timer->stop();  // 取消延迟一小会儿的单击信号
+                stopDoubleTimer();     // 取消延迟一小会儿的单击信号
                 emit doubleClicked();
                 return ;
             }
@@ -1110,8 +1128,13 @@ void InteractiveButtonBase::mousePressEvent(QMouseEvent *event)
         }
         else // 透明渐变
         {
-            if (press_progress < press_start)
-                press_progress = press_start; // 直接设置为按下效果初始值（避免按下反应慢）
+            if (ani.press_progress < button_style->press_start)
+            {
+                ani.press_progress = button_style->press_start; // 直接设置为按下效果初始值（避免按下反应慢）
+                ani.press_direction = 1;
+                ani.press_from_progress = button_style->press_start;
+                ani.press_from_timestamp = press_timestamp;
+            }
         }
     }
     mouse_press_event = event;
@@ -1162,7 +1185,7 @@ void InteractiveButtonBase::mouseReleaseEvent(QMouseEvent* event)
             }
             else // 可能是双击，准备
             {
-                double_timer->start();
+                startDoubleTimer();
                 return ; // 禁止单击事件
             }
         }
@@ -1197,7 +1220,7 @@ void InteractiveButtonBase::mouseMoveEvent(QMouseEvent *event)
     {
         enterEvent(nullptr);
     }
-    mouse_pos = mapFromGlobal(QCursor::pos());
+    mouse_pos = event ? event->pos() : mapFromGlobal(QCursor::pos());
 
     return QPushButton::mouseMoveEvent(event);
 }
@@ -1211,17 +1234,12 @@ void InteractiveButtonBase::resizeEvent(QResizeEvent *event)
     if (!pressing && !hovering)
     {
         mouse_pos = QPoint(geometry().width()/2, geometry().height()/2);
-        anchor_pos = mouse_pos;
+        ani.anchor_pos = mouse_pos;
     }
     water_radius = static_cast<int>(max(geometry().width(), geometry().height()) * 1.42); // 长边
-    // 非固定的情况，尺寸大小变了之后所有 padding 都要变
-    if (model == PaintModel::Icon || model == PaintModel::PixmapMask)
-    {
-        int short_side = min(geometry().width(), geometry().height()); // 短边
-        int padding = short_side*icon_padding_proper; //static_cast<int>(short_side * (1 - GOLDEN_RATIO) / 2);
-        fore_paddings.left = fore_paddings.top = fore_paddings.right = fore_paddings.bottom = padding;
-    }
+    // 图标模式的留白随尺寸变化，由 getForePaddings 实时计算
     _l = _t = 0; _w = size().width(); _h = size().height();
+    invalidateBgPainterPath();
 
     return QPushButton::resizeEvent(event);
 }
@@ -1282,55 +1300,56 @@ void InteractiveButtonBase::paintEvent(QPaintEvent* event)
     QPainter painter(this);
 
     // ==== 绘制背景 ====
-    QPainterPath path_back = getBgPainterPath();
+    QPainterPath path_back = getCachedBgPainterPath();
     painter.setRenderHint(QPainter::Antialiasing,true);
 
-    if (normal_bg.alpha() != 0) // 默认背景
+    if (button_style->normal_bg.alpha() != 0) // 默认背景
     {
-        painter.fillPath(path_back, isEnabled()?normal_bg:getOpacityColor(normal_bg));
+        painter.fillPath(path_back, isEnabled()?button_style->normal_bg:getOpacityColor(button_style->normal_bg));
     }
-    if (focusing && focus_bg.alpha() != 0) // 焦点背景
+    if (focusing && button_style->focus_bg.alpha() != 0) // 焦点背景
     {
-        painter.fillPath(path_back, focus_bg);
+        painter.fillPath(path_back, button_style->focus_bg);
     }
 
-    if ((border_bg.alpha() != 0 || (focusing && focus_border.alpha() != 0)) && border_width > 0)
+    if ((button_style->border_bg.alpha() != 0 || (focusing && button_style->focus_border.alpha() != 0)) && button_style->border_width > 0)
     {
         painter.save();
         QPen pen;
-        pen.setColor((focusing && focus_border.alpha()) ? focus_border : border_bg);
-        pen.setWidth(border_width);
+        pen.setColor((focusing && button_style->focus_border.alpha()) ? button_style->focus_border : button_style->border_bg);
+        pen.setWidth(button_style->border_width);
         painter.setPen(pen);
         painter.drawPath(path_back);
         painter.restore();
     }
 
-    if (hover_progress) // 悬浮背景
+    if (ani.hover_progress) // 悬浮背景
     {
-         painter.fillPath(path_back, getOpacityColor(hover_bg, hover_progress / 100.0));
+         painter.fillPath(path_back, getOpacityColor(button_style->hover_bg, button_style->hover_easing.valueAt(ani.hover_progress)));
     }
 
-    if (press_progress && !water_animation) // 按下渐变淡化消失
+    if (ani.press_progress && !water_animation) // 按下渐变淡化消失
     {
-        painter.fillPath(path_back, getOpacityColor(press_bg, press_progress/100.0));
+        painter.fillPath(path_back, getOpacityColor(button_style->press_bg, ani.press_progress/100.0));
     }
     else if (water_animation && waters.size()) // 水波纹，且至少有一个水波纹
     {
-        paintWaterRipple(painter);
+        paintWaterRipple(painter, path_back);
     }
 
     // ==== 绘制前景 ====
     if (fore_enabled/*针对按钮设置*/ && show_foreground/*针对动画设置*/)
     {
-        painter.setPen(isEnabled()?icon_color:getOpacityColor(icon_color));
+        painter.setPen(isEnabled()?button_style->icon_color:getOpacityColor(button_style->icon_color));
+        const EdgeVal paddings = getForePaddings();
 
         // 绘制额外内容（可能被前景覆盖）
         if (paint_addin.enable)
         {
-            int l = fore_paddings.left, t = fore_paddings.top, r = size().width()-fore_paddings.right, b = size().height()-fore_paddings.bottom;
+            int l = paddings.left, t = paddings.top, r = size().width()-paddings.right, b = size().height()-paddings.bottom;
             int small_edge = min(size().height(), size().width());
-            int pw = paint_addin.size.width() ? paint_addin.size.width() : small_edge-fore_paddings.left-fore_paddings.right;
-            int ph = paint_addin.size.height() ? paint_addin.size.height() : small_edge-fore_paddings.top-fore_paddings.bottom;
+            int pw = paint_addin.size.width() ? paint_addin.size.width() : small_edge-paddings.left-paddings.right;
+            int ph = paint_addin.size.height() ? paint_addin.size.height() : small_edge-paddings.top-paddings.bottom;
             if (paint_addin.align & Qt::AlignLeft)
                 r = l + pw;
             else if (paint_addin.align & Qt::AlignRight)
@@ -1349,19 +1368,21 @@ void InteractiveButtonBase::paintEvent(QPaintEvent* event)
                 t = size().height()/2-ph/2;
                 b = t+ph;
             }
-            painter.drawPixmap(QRect(l,t,r-l,b-t), paint_addin.pixmap);
+            QRect addin_rect(l,t,r-l,b-t);
+            painter.drawPixmap(addin_rect, getTintedPixmap(tinted_addin, paint_addin.pixmap, getIconPaintColor(),
+                                                           addin_rect.size(), painter.device()->devicePixelRatioF()));
         }
 
         QRect& rect = paint_rect;
-        rect = QRect(fore_paddings.left+(fixed_fore_pos?0:offset_pos.x()), fore_paddings.top+(fixed_fore_pos?0:offset_pos.y()), // 原来的位置，不包含点击、出现效果
-                   (size().width()-fore_paddings.left-fore_paddings.right),
-                   size().height()-fore_paddings.top-fore_paddings.bottom);
+        rect = QRect(paddings.left+(fixed_fore_pos?0:ani.offset_pos.x()), paddings.top+(fixed_fore_pos?0:ani.offset_pos.y()), // 原来的位置，不包含点击、出现效果
+                   (size().width()-paddings.left-paddings.right),
+                   size().height()-paddings.top-paddings.bottom);
 
         // 抖动出现动画
-        if ((show_ani_appearing || show_ani_disappearing) && show_ani_point != QPoint( 0, 0 ) && ! fixed_fore_pos)
+        if ((ani.show_ani_appearing || ani.show_ani_disappearing) && show_ani_point != QPoint( 0, 0 ) && ! fixed_fore_pos)
         {
             //int w = size().width(), h = size().height();
-            int pro = getSpringBackProgress(show_ani_progress, 50);
+            int pro = getSpringBackProgress(ani.show_ani_progress, 50);
 
             // show_ani_point 是鼠标进入的点，那么起始方向应该是相反的
             int x = show_ani_point.x(), y = show_ani_point.y();
@@ -1380,33 +1401,33 @@ void InteractiveButtonBase::paintEvent(QPaintEvent* event)
         else if (align == Qt::AlignCenter && model != PaintModel::Text && !fixed_fore_size) // 默认的缩放动画
         {
             int delta_x = 0, delta_y = 0;
-            if (click_ani_progress != 0) // 图标缩放
+            if (ani.click_ani_progress != 0) // 图标缩放
             {
-                delta_x = rect.width() * click_ani_progress / 400;
-                delta_y = rect.height() * click_ani_progress / 400;
+                delta_x = rect.width() * ani.click_ani_progress / 400;
+                delta_y = rect.height() * ani.click_ani_progress / 400;
             }
-            else if (show_ani_appearing)
+            else if (ani.show_ani_appearing)
             {
                 /*int pro; // 将动画进度转换为回弹动画进度
-                if (show_ani_progress <= 50)
-                    pro = show_ani_progress * 2;
-                else if (show_ani_progress <= 75)
-                    pro = (show_ani_progress-50)/2 + 100;
+                if (ani.show_ani_progress <= 50)
+                    pro = ani.show_ani_progress * 2;
+                else if (ani.show_ani_progress <= 75)
+                    pro = (ani.show_ani_progress-50)/2 + 100;
                 else
-                    pro = 100 + (100-show_ani_progress)/2;
+                    pro = 100 + (100-ani.show_ani_progress)/2;
 
                 delta_x = rect.width() * (100-pro) / 100;
                 delta_y = rect.height() * (100-pro) / 100;*/
 
-                double pro = getNolinearProg(show_ani_progress, SpringBack50);
+                double pro = getNolinearProg(ani.show_ani_progress, SpringBack50);
                 delta_x = static_cast<int>(rect.width() * (1-pro));
                 delta_y = static_cast<int>(rect.height() * (1-pro));
             }
-            else if (show_ani_disappearing)
+            else if (ani.show_ani_disappearing)
             {
-                double pro = 1 - getNolinearProg(show_ani_progress, SlowFaster);
-                delta_x = rect.width() * pro; // (100-show_ani_progress) / 100;
-                delta_y = rect.height() * pro; // (100-show_ani_progress) / 100;
+                double pro = 1 - getNolinearProg(ani.show_ani_progress, SlowFaster);
+                delta_x = rect.width() * pro; // (100-ani.show_ani_progress) / 100;
+                delta_y = rect.height() * pro; // (100-ani.show_ani_progress) / 100;
             }
             if (delta_x || delta_y)
                 rect = QRect(rect.left()+delta_x, rect.top()+delta_y,
@@ -1415,7 +1436,7 @@ void InteractiveButtonBase::paintEvent(QPaintEvent* event)
 
         /*if (this->isEnabled())
         {
-            QColor color = icon_color;
+            QColor color = button_style->icon_color;
             color.setAlpha(color.alpha() / 2);
             painter.setPen(color);
         }*/
@@ -1424,66 +1445,142 @@ void InteractiveButtonBase::paintEvent(QPaintEvent* event)
         {
             // 子类自己的绘制内容
         }
-        else if (model == Text)
+        else if (fore_layer_cache) // 前景图层缓存：只平移、缩放图层
         {
-            // 绘制文字教程： https://blog.csdn.net/temetnosce/article/details/78068464
-            painter.setPen(isEnabled()?text_color:getOpacityColor(text_color));
-            /*if (show_ani_appearing || show_ani_disappearing)
-            {
-                int pro = getSpringBackProgress(show_ani_progress, 50);
-                QFont font = painter.font();
-                int ps = font.pointSize();
-                ps = ps * show_ani_progress / 100;
-                font.setPointSize(ps);
-                painter.setFont(font);
-            }*/
-            if (font_size > 0)
-            {
-                QFont font = painter.font();
-                font.setPointSize(font_size);
-                painter.setFont(font);
-            }
-            painter.drawText(rect, static_cast<int>(align), text);
+            paintForeLayer(painter, rect);
         }
-        else if (model == Icon) // 绘制图标
-        {
-            icon.paint(&painter, rect, align, getIconMode());
-        }
-        else if (model == PixmapMask)
-        {
-            painter.setRenderHint(QPainter::SmoothPixmapTransform, true); // 可以让边缘看起来平滑一些
-            painter.drawPixmap(rect, pixmap);
-        }
-        else if (model == IconText || model == PixmapText) // 强制左对齐；左图标中文字
+        else
         {
-            // 绘制图标
-            int& sz = icon_text_size;
-            QRect icon_rect(rect.left(), rect.top() + rect.height()/2 - sz / 2, sz, sz);
-            icon_rect.moveTo(icon_rect.left() - quick_sqrt(offset_pos.x()), icon_rect.top() - quick_sqrt(offset_pos.y()));
-            drawIconBeforeText(painter, icon_rect);
-            rect.setLeft(rect.left() + sz + icon_text_padding);
-
-            // 绘制文字
-            // 扩展文字范围，确保文字可见
-            painter.setPen(isEnabled()?text_color:getOpacityColor(text_color));
-            rect.setWidth(rect.width() + sz + icon_text_padding);
-            if (font_size > 0)
-            {
-                QFont font = painter.font();
-                font.setPointSize(font_size);
-                painter.setFont(font);
-            }
-            painter.drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, text);
+            paintForeground(painter, rect);
         }
     }
 
     // ==== 绘制鼠标位置 ====
-//    painter.drawEllipse(QRect(anchor_pos.x()-5, anchor_pos.y()-5, 10, 10)); // 移动锚点
-//    painter.drawEllipse(QRect(effect_pos.x()-2, effect_pos.y()-2, 4, 4)); // 影响位置锚点
+//    painter.drawEllipse(QRect(ani.anchor_pos.x()-5, ani.anchor_pos.y()-5, 10, 10)); // 移动锚点
+//    painter.drawEllipse(QRect(ani.effect_pos.x()-2, ani.effect_pos.y()-2, 4, 4)); // 影响位置锚点
 
     //    return QPushButton::paintEvent(event); // 不绘制父类背景了
 }
 
+/**
+ * 绘制前景内容（文字、图标）
+ * @param painter 绘制对象
+ * @param rect    前景区域
+ * @param layered 是否绘制到前景图层（不包含动画偏移）
+ */
+void InteractiveButtonBase::paintForeground(QPainter &painter, QRect rect, bool layered)
+{
+    if (model == Text)
+    {
+        // 绘制文字教程： https://blog.csdn.net/temetnosce/article/details/78068464
+        painter.setPen(isEnabled()?button_style->text_color:getOpacityColor(button_style->text_color));
+        /*if (ani.show_ani_appearing || ani.show_ani_disappearing)
+        {
+            int pro = getSpringBackProgress(ani.show_ani_progress, 50);
+            QFont font = painter.font();
+            int ps = font.pointSize();
+            ps = ps * ani.show_ani_progress / 100;
+            font.setPointSize(ps);
+            painter.setFont(font);
+        }*/
+        drawForeText(painter, rect, static_cast<int>(align), text);
+    }
+    else if (model == Icon) // 绘制图标
+    {
+        icon.paint(&painter, rect, align, getIconMode());
+    }
+    else if (model == PixmapMask)
+    {
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true); // 可以让边缘看起来平滑一些
+        painter.drawPixmap(rect, getTintedPixmap(tinted_pixmap, pixmap, getIconPaintColor(),
+                                                 rect.size(), painter.device()->devicePixelRatioF()));
+    }
+    else if (model == IconText || model == PixmapText) // 强制左对齐；左图标中文字
+    {
+        // 绘制图标
+        int& sz = icon_text_size;
+        QRect icon_rect(rect.left(), rect.top() + rect.height()/2 - sz / 2, sz, sz);
+        if (!layered) // 图层中不包含动画偏移
+            icon_rect.moveTo(icon_rect.left() - quick_sqrt(ani.offset_pos.x()), icon_rect.top() - quick_sqrt(ani.offset_pos.y()));
+        drawIconBeforeText(painter, icon_rect);
+        rect.setLeft(rect.left() + sz + button_style->icon_text_padding);
+
+        // 绘制文字
+        // 扩展文字范围，确保文字可见
+        painter.setPen(isEnabled()?button_style->text_color:getOpacityColor(button_style->text_color));
+        rect.setWidth(rect.width() + sz + button_style->icon_text_padding);
+        drawForeText(painter, rect, Qt::AlignLeft | Qt::AlignVCenter, text);
+    }
+}
+
+/**
+ * 使用前景图层缓存绘制前景
+ * 前景只在内容、颜色、尺寸改变时重新绘制到图层（按设备像素比）
+ * 悬浮偏移、点击缩放、出现动画时只平移、缩放图层
+ * @param painter 绘制对象
+ * @param rect    本帧的前景区域（包含各种动画效果）
+ */
+void InteractiveButtonBase::paintForeLayer(QPainter &painter, QRect rect)
+{
+    const EdgeVal paddings = getForePaddings();
+    QSize size(width() - paddings.left - paddings.right, height() - paddings.top - paddings.bottom);
+    if (size.isEmpty() || rect.isEmpty())
+        return ;
+
+    qreal dpr = painter.device()->devicePixelRatioF();
+    const QFont& font = getPaintFont();
+    QRgb text_rgba = (isEnabled() ? button_style->text_color : getOpacityColor(button_style->text_color)).rgba();
+    QRgb icon_rgba = getIconPaintColor().rgba();
+    int icon_mode = static_cast<int>(getIconMode());
+    ForeLayer& layer = fore_layer;
+    if (layer.pixmap.isNull() || layer.size != size || !qFuzzyCompare(layer.dpr, dpr)
+            || layer.model != model || layer.align != static_cast<int>(align)
+            || layer.text != text || layer.font_revision != paint_font_revision
+            || layer.text_color != text_rgba || layer.icon_color != icon_rgba
+            || layer.icon_key != icon.cacheKey() || layer.icon_mode != icon_mode
+            || layer.icon_size != icon_text_size || layer.pixmap_key != pixmap.cacheKey())
+    {
+        layer.size = size;
+        layer.dpr = dpr;
+        layer.model = model;
+        layer.align = static_cast<int>(align);
+        layer.text = text;
+        layer.font_revision = paint_font_revision;
+        layer.text_color = text_rgba;
+        layer.icon_color = icon_rgba;
+        layer.icon_key = icon.cacheKey();
+        layer.icon_mode = icon_mode;
+        layer.icon_size = icon_text_size;
+        layer.pixmap_key = pixmap.cacheKey();
+
+        layer.pixmap = QPixmap(size * dpr);
+        layer.pixmap.setDevicePixelRatio(dpr);
+        layer.pixmap.fill(Qt::transparent);
+        QPainter layer_painter(&layer.pixmap);
+        layer_painter.setRenderHint(QPainter::Antialiasing, true);
+        layer_painter.setFont(font);
+        layer_painter.setPen(QColor::fromRgba(icon_rgba));
+        paintForeground(layer_painter, QRect(QPoint(0, 0), size), true);
+    }
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    painter.drawPixmap(rect, layer.pixmap);
+}
+
+/**
+ * 设置是否使用前景图层缓存
+ * 开启后前景（文字、图标）绘制一次到图层，动画时只平移、缩放图层，适合大量按钮同时动画
+ * 缩放动画时文字会随图层一起缩放；图标+文字模式下图标不再单独偏移
+ * @param enable 开关
+ */
+void InteractiveButtonBase::setForeLayerCache(bool enable)
+{
+    fore_layer_cache = enable;
+    if (!enable)
+        fore_layer = ForeLayer(); // 释放图层
+    update();
+}
+
 /**
  * IconText/PixmapText模式下，绘制图标
  * 可扩展到绘制图标背景色（模仿menu选中、禁用情况）等
@@ -1493,7 +1590,8 @@ void InteractiveButtonBase::drawIconBeforeText(QPainter& painter, QRect icon_rec
     if (model == IconText)
         icon.paint(&painter, icon_rect, align, getIconMode());
     else if (model == PixmapText)
-        painter.drawPixmap(icon_rect, pixmap);
+        painter.drawPixmap(icon_rect, getTintedPixmap(tinted_pixmap, pixmap, getIconPaintColor(),
+                                                      icon_rect.size(), painter.device()->devicePixelRatioF()));
 }
 
 /**
@@ -1516,36 +1614,185 @@ bool InteractiveButtonBase::inArea(QPoint point)
 QPainterPath InteractiveButtonBase::getBgPainterPath()
 {
     QPainterPath path;
-    if (radius_x || radius_y)
-        path.addRoundedRect(QRect(0,0,size().width(),size().height()), radius_x, radius_y);
+    if (button_style->radius_x || button_style->radius_y)
+        path.addRoundedRect(QRect(0,0,size().width(),size().height()), button_style->radius_x, button_style->radius_y);
     else
         path.addRect(QRect(0,0,size().width(),size().height()));
     return path;
 }
 
 /**
- * 获取水波纹绘制区域（圆形，但不规则区域）
- * 圆形水面 & 按钮区域
+ * 背景形状是否可以缓存
+ * 形状随动画实时变化的子类（例如跟随鼠标）返回 false，每次重新计算
+ * @return 是否可以缓存
+ */
+bool InteractiveButtonBase::isBgPainterPathCacheable()
+{
+    return true;
+}
+
+/**
+ * 子类额外的形状参数
+ * 尺寸、圆角之外的参数（例如悬浮进度），变化后自动重建缓存
+ * @return 形状参数的键值
+ */
+qint64 InteractiveButtonBase::getBgPainterPathKey()
+{
+    return 0;
+}
+
+/**
+ * 获取缓存的背景绘制区域
+ * 绘制时应当使用这个方法，只在尺寸、圆角、子类形状参数变化时重新计算
+ * @return 背景路径
+ */
+QPainterPath InteractiveButtonBase::getCachedBgPainterPath()
+{
+    if (!isBgPainterPathCacheable())
+    {
+        BUTTON_PROFILE_SCOPE(PathBuild);
+        return getBgPainterPath();
+    }
+
+    qint64 key = getBgPainterPathKey();
+    if (!bg_path_valid || bg_path_size != size() || bg_path_key != key
+            || bg_path_radius_x != button_style->radius_x || bg_path_radius_y != button_style->radius_y)
+    {
+        BUTTON_PROFILE_SCOPE(PathBuild);
+        bg_path_cache = getBgPainterPath();
+        bg_path_size = size();
+        bg_path_radius_x = button_style->radius_x;
+        bg_path_radius_y = button_style->radius_y;
+        bg_path_key = key;
+        bg_path_valid = true;
+    }
+    return bg_path_cache;
+}
+
+/**
+ * 背景形状缓存失效
+ * 子类修改了影响形状的属性后调用
+ */
+void InteractiveButtonBase::invalidateBgPainterPath()
+{
+    bg_path_valid = false;
+}
+
+/**
+ * 获取水波纹圆形的外接矩形
+ * 绘制时以背景形状为裁剪区域，直接画圆，不需要和背景路径求交集
+ * 子类修改水波纹扩散方式时重写
  * @param  water 一面水波纹动画对象
- * @return       绘制路径
+ * @return       圆形的外接矩形
  */
-QPainterPath InteractiveButtonBase::getWaterPainterPath(InteractiveButtonBase::Water water)
+QRect InteractiveButtonBase::getWaterRect(const InteractiveButtonBase::Water &water)
 {
-    double prog = getNolinearProg(water.progress, FastSlower);
+    double prog = button_style->water_easing.valueAt(water.progress);
     int ra = water_radius*prog;
-    QRect circle(water.point.x() - ra,
-                water.point.y() - ra,
-                ra*2,
-                ra*2);
-    /*QRect circle(water.point.x() - water_radius*water.progress/100,
-                water.point.y() - water_radius*water.progress/100,
-                water_radius*water.progress/50,
-                water_radius*water.progress/50);*/
-    QPainterPath path;
-    path.addEllipse(circle);
-    if (radius_x || radius_y)
-        return path & getBgPainterPath();
-    return path;
+    return QRect(water.point.x() - ra,
+                 water.point.y() - ra,
+                 ra*2,
+                 ra*2);
+}
+
+/**
+ * 获取本帧动画需要重绘的区域
+ * 背景颜色变化时重绘整个按钮，否则只重绘水波纹扩散和前景移动的范围
+ * 背景或前景跟随动画整体变化的子类可以重写，直接返回整个按钮
+ * @return 需要重绘的区域
+ */
+QRegion InteractiveButtonBase::getDirtyRegion()
+{
+    QRect full_rect(0, 0, width(), height());
+    bool water_finished = false;
+    QRect water_rect;
+    for (int i = 0; i < waters.size(); i++)
+    {
+        const Water& water = waters.at(i);
+        if (water.finished)
+            water_finished = true;
+        else
+            water_rect |= getWaterRect(water);
+    }
+
+    // 背景透明度变化、出现/消失动画：整体重绘
+    if (ani.hover_progress != last_hover_progress
+            || (ani.press_progress != last_press_progress && !water_animation)
+            || water_finished || last_water_finished
+            || ani.show_ani_progress != last_show_ani_progress
+            || ani.show_ani_appearing != last_show_ani_appearing
+            || ani.show_ani_disappearing != last_show_ani_disappearing
+            || show_foreground != last_show_foreground)
+        return QRegion(full_rect);
+
+    QRegion region;
+
+    // 水波纹扩散
+    if (water_rect != last_water_rect)
+        region += (water_rect | last_water_rect) & full_rect;
+
+    // 前景移动、点击缩放
+    if (ani.offset_pos != last_offset_pos
+            || ani.click_ani_progress != last_click_ani_progress
+            || ani.click_ani_appearing != last_click_ani_appearing
+            || ani.click_ani_disappearing != last_click_ani_disappearing)
+        region += getForegroundDirtyRect();
+
+    return region;
+}
+
+/**
+ * 获取前景移动前后覆盖的范围
+ * 没有前景模型的（子类自己绘制前景）无法预知，返回整个按钮
+ * @return 前景范围
+ */
+QRect InteractiveButtonBase::getForegroundDirtyRect()
+{
+    QRect full_rect(0, 0, width(), height());
+    if (model == PaintModel::None || !fore_enabled)
+        return full_rect;
+
+    const EdgeVal paddings = getForePaddings();
+    QRect rect(paddings.left, paddings.top,
+               width()-paddings.left-paddings.right,
+               height()-paddings.top-paddings.bottom);
+    if (!fixed_fore_pos)
+        rect = rect.translated(last_offset_pos) | rect.translated(ani.offset_pos);
+    if (model == PaintModel::IconText || model == PaintModel::PixmapText)
+        rect.setRight(full_rect.right()); // 文字区域向右扩展
+
+    // 图标+文字模式的图标额外偏移，以及抗锯齿的边缘
+    int margin = 2 + max(qAbs(quick_sqrt(ani.offset_pos.x())), qAbs(quick_sqrt(ani.offset_pos.y())));
+    margin = max(margin, 2 + max(qAbs(quick_sqrt(last_offset_pos.x())), qAbs(quick_sqrt(last_offset_pos.y()))));
+    return rect.adjusted(-margin, -margin, margin, margin) & full_rect;
+}
+
+/**
+ * 记录本帧的动画状态，作为下一帧局部刷新的对比
+ */
+void InteractiveButtonBase::saveDirtyState()
+{
+    last_hover_progress = ani.hover_progress;
+    last_press_progress = ani.press_progress;
+    last_click_ani_progress = ani.click_ani_progress;
+    last_show_ani_progress = ani.show_ani_progress;
+    last_click_ani_appearing = ani.click_ani_appearing;
+    last_click_ani_disappearing = ani.click_ani_disappearing;
+    last_show_ani_appearing = ani.show_ani_appearing;
+    last_show_ani_disappearing = ani.show_ani_disappearing;
+    last_show_foreground = show_foreground;
+    last_offset_pos = ani.offset_pos;
+
+    last_water_rect = QRect();
+    last_water_finished = false;
+    for (int i = 0; i < waters.size(); i++)
+    {
+        const Water& water = waters.at(i);
+        if (water.finished)
+            last_water_finished = true;
+        else
+            last_water_rect |= getWaterRect(water);
+    }
 }
 
 /**
@@ -1557,7 +1804,7 @@ QPainterPath InteractiveButtonBase::getWaterPainterPath(InteractiveButtonBase::W
 QRect InteractiveButtonBase::getUnifiedGeometry()
 {
     // 将动画进度转换为回弹动画进度
-    int pro = show_ani_appearing ? getSpringBackProgress(show_ani_progress,50) : show_ani_progress;
+    int pro = ani.show_ani_appearing ? getSpringBackProgress(ani.show_ani_progress,50) : ani.show_ani_progress;
     int ul = 0, ut = 0, uw = size().width(), uh = size().height();
 
     // show_ani_point 是鼠标进入的点，那么起始方向应该是相反的
@@ -1581,10 +1828,10 @@ QRect InteractiveButtonBase::getUnifiedGeometry()
 void InteractiveButtonBase::updateUnifiedGeometry()
 {
     _l = 0; _t = 0; _w = geometry().width(); _h = geometry().height();
-    if ((show_ani_appearing || show_ani_disappearing) && show_ani_point != QPoint( 0, 0 ))
+    if ((ani.show_ani_appearing || ani.show_ani_disappearing) && show_ani_point != QPoint( 0, 0 ))
     {
         int pro; // 将动画进度转换为回弹动画进度
-        pro = show_ani_appearing ? getSpringBackProgress(show_ani_progress,50) : show_ani_progress;
+        pro = ani.show_ani_appearing ? getSpringBackProgress(ani.show_ani_progress,50) : ani.show_ani_progress;
 
         // show_ani_point 是鼠标进入的点，那么起始方向应该是相反的
         int x = show_ani_point.x(), y = show_ani_point.y();
@@ -1601,28 +1848,32 @@ void InteractiveButtonBase::updateUnifiedGeometry()
 
 /**
  * 绘制一个水波纹动画
- * @param painter 绘制对象（即painter(this)对象）
+ * @param painter   绘制对象（即painter(this)对象）
+ * @param path_back 本次绘制的背景形状（形状随动画变化、不缓存的子类每次绘制只计算一次）
  */
-void InteractiveButtonBase::paintWaterRipple(QPainter& painter)
+void InteractiveButtonBase::paintWaterRipple(QPainter& painter, const QPainterPath& path_back)
 {
-    QColor water_finished_color(press_bg);
+    QColor water_finished_color(button_style->press_bg);
 
+    // 背景形状作为裁剪区域，每个水波纹只需要画一个圆
+    painter.save();
+    painter.setClipPath(path_back, Qt::IntersectClip);
+    painter.setPen(Qt::NoPen);
     for (int i = 0; i < waters.size(); i++)
     {
-        Water water = waters.at(i);
+        const Water& water = waters.at(i);
         if (water.finished) // 渐变消失
         {
-            water_finished_color.setAlpha(press_bg.alpha() * water.progress / 100);
-            QPainterPath path_back = getBgPainterPath();
-//                painter.setPen(water_finished_color);
-            painter.fillPath(path_back, QBrush(water_finished_color));
+            water_finished_color.setAlpha(button_style->press_bg.alpha() * water.progress / 100);
+            painter.fillRect(rect(), water_finished_color);
         }
         else // 圆形出现
         {
-            QPainterPath path = getWaterPainterPath(water);
-            painter.fillPath(path, QBrush(press_bg));
+            painter.setBrush(button_style->press_bg);
+            painter.drawEllipse(getWaterRect(water));
         }
     }
+    painter.restore();
 }
 
 /**
@@ -1633,25 +1884,25 @@ void InteractiveButtonBase::setJitter()
 {
     jitters.clear();
     QPoint center_pos = geometry().center()-geometry().topLeft();
-    int full_manh = (anchor_pos-center_pos).manhattanLength(); // 距离
+    int full_manh = (ani.anchor_pos-center_pos).manhattanLength(); // 距离
     // 是否达到需要抖动的距离
     if (full_manh > (geometry().topLeft() - geometry().bottomRight()).manhattanLength()) // 距离超过外接圆半径，开启抖动
     {
-        QPoint jitter_pos(effect_pos);
+        QPoint jitter_pos(ani.effect_pos);
         full_manh = (jitter_pos-center_pos).manhattanLength();
         int manh = full_manh;
-        int duration = jitter_duration;
+        int duration = button_style->jitter_duration;
         qint64 timestamp = release_timestamp;
-        while (manh > elastic_coefficient)
+        while (manh > button_style->elastic_coefficient)
         {
             jitters << Jitter(jitter_pos, timestamp);
-            jitter_pos = center_pos - (jitter_pos - center_pos) / elastic_coefficient;
-            duration = jitter_duration * manh / full_manh;
+            jitter_pos = center_pos - (jitter_pos - center_pos) / button_style->elastic_coefficient;
+            duration = button_style->jitter_duration * manh / full_manh;
             timestamp += duration;
-            manh = static_cast<int>(manh / elastic_coefficient);
+            manh = static_cast<int>(manh / button_style->elastic_coefficient);
         }
         jitters << Jitter(center_pos, timestamp);
-        anchor_pos = mouse_pos = center_pos;
+        ani.anchor_pos = mouse_pos = center_pos;
     }
     else if (!hovering) // 悬浮的时候依旧有效
     {
@@ -1718,12 +1969,27 @@ int InteractiveButtonBase::max(int a, int b) const { return a > b ? a : b; }
 int InteractiveButtonBase::min(int a, int b) const { return a < b ? a : b; }
 
 /**
- * 获取现行时间戳，13位，精确到毫秒
+ * 前景四周实际的留白
+ * 图标模式按短边乘以 icon_padding_proper 实时计算，属于单个按钮，不写回共享的样式
+ */
+InteractiveButtonBase::EdgeVal InteractiveButtonBase::getForePaddings() const
+{
+    if (model == PaintModel::Icon || model == PaintModel::PixmapMask)
+    {
+        int padding = static_cast<int>(min(width(), height()) * button_style->icon_padding_proper);
+        return EdgeVal(padding, padding, padding, padding);
+    }
+    return button_style->fore_paddings;
+}
+
+/**
+ * 获取动画时间戳，精确到毫秒
+ * 使用单调时钟，不受系统时间调整影响；同一帧内所有按钮共用一个时间戳
  * @return 时间戳
  */
 qint64 InteractiveButtonBase::getTimestamp() const
 {
-    return QDateTime::currentDateTime().toMSecsSinceEpoch();
+    return ButtonAnimationDriver::instance()->timestamp();
 }
 
 /**
@@ -1752,6 +2018,23 @@ int InteractiveButtonBase::getSpringBackProgress(int x, int max)
     return 100 + (100-x)/2;
 }
 
+/**
+ * 根据时间戳计算渐变动画的进度
+ * @param  from           渐变开始时的进度
+ * @param  from_timestamp 渐变开始的时间戳
+ * @param  direction      渐变方向：1加深、-1变浅、0不变
+ * @param  duration       从 0 到 100 的完整时长（毫秒）
+ * @param  timestamp      当前时间戳
+ * @return                当前进度（0~100）
+ */
+int InteractiveButtonBase::getTimedProgress(int from, qint64 from_timestamp, int direction, int duration, qint64 timestamp)
+{
+    if (duration <= 0)
+        return direction > 0 ? 100 : (direction < 0 ? 0 : from);
+    int delta = static_cast<int>((timestamp - from_timestamp) * 100 / duration);
+    return qBound(0, from + direction * delta, 100);
+}
+
 /**
  * 获取透明的颜色
  * @param  color 颜色
@@ -1766,47 +2049,193 @@ QColor InteractiveButtonBase::getOpacityColor(QColor color, double level)
 
 /**
  * 获取对应颜色的图标 pixmap
+ * 保留原图标的透明度（SourceIn 合成），边缘抗锯齿，不经过 1 位的 QBitmap 遮罩
  * @param  p 图标
  * @param  c 颜色
  * @return   对应颜色的图标
  */
 QPixmap InteractiveButtonBase::getMaskPixmap(QPixmap p, QColor c)
 {
-    QBitmap mask = p.mask();
-    p.fill(c);
-    p.setMask(mask);
-    return p;
+    QImage image = p.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    qreal dpr = image.devicePixelRatio();
+    image.setDevicePixelRatio(1); // 按实际像素填充
+    QPainter painter(&image);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(image.rect(), c);
+    painter.end();
+    image.setDevicePixelRatio(dpr);
+    return QPixmap::fromImage(image);
 }
 
-double InteractiveButtonBase::getNolinearProg(int p, InteractiveButtonBase::NolinearType type)
+/**
+ * 获取着色并缩放后的图标
+ * 使用全局 QPixmapCache，所有相同图标、颜色、尺寸的按钮共用一张 pixmap
+ * 尺寸向上取整到 PIXMAP_SIZE_BUCKET 的倍数，绘制时再微调到实际尺寸
+ * @param  p    原始图标
+ * @param  c    颜色
+ * @param  size 绘制尺寸（逻辑像素）
+ * @param  dpr  设备像素比
+ * @return      着色后的图标
+ */
+QPixmap InteractiveButtonBase::getTintedPixmap(const QPixmap &p, QColor c, QSize size, qreal dpr)
+{
+    if (p.isNull() || size.isEmpty())
+        return QPixmap();
+    QSize bucket((size.width() + PIXMAP_SIZE_BUCKET - 1) / PIXMAP_SIZE_BUCKET * PIXMAP_SIZE_BUCKET,
+                 (size.height() + PIXMAP_SIZE_BUCKET - 1) / PIXMAP_SIZE_BUCKET * PIXMAP_SIZE_BUCKET);
+    QString key = QString("interactive_button_tint_%1_%2_%3x%4_%5")
+            .arg(p.cacheKey()).arg(c.rgba(), 8, 16, QChar('0'))
+            .arg(bucket.width()).arg(bucket.height()).arg(qRound(dpr * 100));
+
+    QPixmap tinted;
+    if (QPixmapCache::find(key, &tinted))
+        return tinted;
+    // 先缩放再着色：大图标只着色缩小后的像素
+    tinted = getMaskPixmap(p.scaled(bucket * dpr, Qt::IgnoreAspectRatio, Qt::SmoothTransformation), c);
+    tinted.setDevicePixelRatio(dpr);
+    QPixmapCache::insert(key, tinted);
+    return tinted;
+}
+
+/**
+ * 获取着色并缩放后的图标，参数与上一次相同时直接复用
+ * @param  tinted 上一次的结果，参数变化时更新
+ * @return        着色后的图标
+ */
+const QPixmap &InteractiveButtonBase::getTintedPixmap(TintedPixmap &tinted, const QPixmap &p, QColor c, QSize size, qreal dpr)
+{
+    QSize bucket((size.width() + PIXMAP_SIZE_BUCKET - 1) / PIXMAP_SIZE_BUCKET * PIXMAP_SIZE_BUCKET,
+                 (size.height() + PIXMAP_SIZE_BUCKET - 1) / PIXMAP_SIZE_BUCKET * PIXMAP_SIZE_BUCKET);
+    if (tinted.source_key != p.cacheKey() || tinted.color != c.rgba()
+            || tinted.size != bucket || !qFuzzyCompare(tinted.dpr, dpr))
+    {
+        tinted.source_key = p.cacheKey();
+        tinted.color = c.rgba();
+        tinted.size = bucket;
+        tinted.dpr = dpr;
+        tinted.pixmap = getTintedPixmap(p, c, size, dpr);
+    }
+    return tinted.pixmap;
+}
+
+/**
+ * 绘制文字使用的字体
+ * 即按钮字体，并应用 font_size；只在字体改变后重新计算
+ */
+const QFont &InteractiveButtonBase::getPaintFont()
+{
+    if (!paint_font_valid)
+    {
+        paint_font = font();
+        if (font_size > 0)
+            paint_font.setPointSize(font_size);
+        paint_font_valid = true;
+        paint_font_revision++;
+    }
+    return paint_font;
+}
+
+/**
+ * 绘制前景文字
+ * 单行文字使用排版好的 QStaticText，动画时只改变位置，不重新排版
+ * 多行、自动换行的文字仍然使用 drawText
+ * @param painter 绘制对象
+ * @param rect    文字区域
+ * @param flags   对齐方式
+ * @param text    文字
+ */
+void InteractiveButtonBase::drawForeText(QPainter &painter, QRect rect, int flags, const QString &text)
 {
-    if (p <= 0)
-        return 0.0;
-    if (p >= 100)
-        return 1.0;
-
-    switch (type)
-    {
-    case Linear:
-        return p / 100.0;
-    case SlowFaster:
-        return p * p / 10000.0;
-    case FastSlower :
-        return quick_sqrt(p*100) / 100.0;
-    case SlowFastSlower:
-        if (p <= 50)
-            return p * p / 50.0;
+    const QFont& font = getPaintFont();
+    painter.setFont(font);
+    if ((flags & Qt::TextWordWrap) || text.contains('\n'))
+    {
+        painter.drawText(rect, flags, text);
+        return ;
+    }
+
+    if (text_layout.text != text || text_layout.font_revision != paint_font_revision)
+    {
+        text_layout.text = text;
+        text_layout.font_revision = paint_font_revision;
+        text_layout.static_text.setText(text);
+        text_layout.static_text.setTextFormat(Qt::PlainText);
+        text_layout.static_text.setPerformanceHint(QStaticText::AggressiveCaching);
+        text_layout.static_text.prepare(QTransform(), font);
+    }
+
+    QSizeF size = text_layout.static_text.size();
+    qreal x = rect.left(), y = rect.top();
+    if (flags & Qt::AlignRight)
+        x = rect.left() + rect.width() - size.width();
+    else if (flags & Qt::AlignHCenter)
+        x = rect.left() + (rect.width() - size.width()) / 2;
+    if (flags & Qt::AlignBottom)
+        y = rect.top() + rect.height() - size.height();
+    else if (flags & Qt::AlignVCenter)
+        y = rect.top() + (rect.height() - size.height()) / 2;
+    painter.drawStaticText(QPointF(x, y), text_layout.static_text);
+}
+
+/**
+ * 当前绘制可变色图标的颜色
+ * 不可用时半透明
+ */
+QColor InteractiveButtonBase::getIconPaintColor()
+{
+    return isEnabled() ? button_style->icon_color : getOpacityColor(button_style->icon_color);
+}
+
+/**
+ * 各种非线性曲线的查找表，第一次使用时生成，所有按钮共用
+ */
+const EasingTable &InteractiveButtonBase::getEasingTable(InteractiveButtonBase::NolinearType type)
+{
+    // 与 getSpringBackProgress(x, max) 相同：max 之前到达终点，之后回弹再回到终点
+    auto spring_back20 = [](double t) {
+        if (t <= 0.2)
+            return t / 0.2;
+        else if (t <= 0.6)
+            return 1.0 + (t - 0.2) / 2;
         else
-            return 0.5 + quick_sqrt(50*(p-50))/100.0;
-    case SpringBack20:
-    case SpringBack50:
-        if (p <= 50)
-            return p / 50.0;
-        else if (p < 75)
-            return 1.0 + (p-50) / 200.0;
+            return 1.0 + (1 - t) / 2;
+    };
+    auto spring_back50 = [](double t) {
+        if (t <= 0.5)
+            return 2 * t;
+        else if (t < 0.75)
+            return 1.0 + (t - 0.5) / 2;
         else
-            return 1.0 + (100-p) / 200.0;
-    }
+            return 1.0 + (1 - t) / 2;
+    };
+    static const EasingTable tables[] = {
+        EasingTable(), // Linear
+        EasingTable([](double t) { return t * t; }), // SlowFaster
+        EasingTable([](double t) { return qSqrt(t); }), // FastSlower
+        EasingTable([](double t) { // SlowFastSlower
+            if (t <= 0.5)
+                return 2 * t * t;
+            return 0.5 + qSqrt(0.5 * (t - 0.5));
+        }),
+        EasingTable(spring_back20), // SpringBack20
+        EasingTable(spring_back50), // SpringBack50
+        EasingTable::cubicBezier(0.42, 0, 0.58, 1), // EaseInOut
+        EasingTable::spring(0.3, 2.5) // SpringDamped
+    };
+    return tables[type];
+}
+
+double InteractiveButtonBase::getNolinearProg(int p, InteractiveButtonBase::NolinearType type)
+{
+    return getEasingTable(type).valueAt(p);
+}
+
+/**
+ * 自定义曲线（例如 EasingTable::cubicBezier、EasingTable::spring 生成的）
+ */
+double InteractiveButtonBase::getNolinearProg(int p, const EasingTable &table)
+{
+    return table.valueAt(p);
 }
 
 QIcon::Mode InteractiveButtonBase::getIconMode()
@@ -1814,101 +2243,108 @@ QIcon::Mode InteractiveButtonBase::getIconMode()
     return isEnabled() ? (getState() ? QIcon::Selected : (hovering||pressing ? QIcon::Active : QIcon::Normal)) : QIcon::Disabled;
 }
 
+/**
+ * 开始刷新动画
+ * 加入全局动画驱动器，和其他按钮共用一个定时器
+ */
+void InteractiveButtonBase::startAnimation()
+{
+    ButtonAnimationDriver::instance()->registerTarget(this);
+}
+
+/**
+ * 停止刷新动画
+ * 从全局动画驱动器中注销（可在 anchorTimeOut 中调用）
+ */
+void InteractiveButtonBase::stopAnimation()
+{
+    ButtonAnimationDriver::instance()->unregisterTarget(this);
+}
+
+/**
+ * 是否正在刷新动画
+ */
+bool InteractiveButtonBase::isAnimating()
+{
+    return ButtonAnimationDriver::instance()->isRegistered(this);
+}
+
+/**
+ * 全局动画驱动器的一帧
+ */
+void InteractiveButtonBase::animationTick()
+{
+    BUTTON_PROFILE_SCOPE(Tick);
+    anchorTimeOut();
+}
+
+/**
+ * 按钮所在的屏幕
+ * 动画驱动器按照这个屏幕的刷新率刷新本按钮
+ */
+QScreen *InteractiveButtonBase::animationScreen()
+{
+    QWidget* win = window();
+    if (win && win->windowHandle())
+        return win->windowHandle()->screen();
+    return nullptr;
+}
+
 /**
  * 锚点变成到鼠标位置的定时时钟
+ * 由全局动画驱动器每帧调用
  * 同步计算所有和时间或者帧数有关的动画和属性
  */
 void InteractiveButtonBase::anchorTimeOut()
 {
     qint64 timestamp = getTimestamp();
     // ==== 背景色 ====
-    /*if (hovering) // 在框内：加深
+    // 根据时间戳计算渐变进度，即使刷新不及时（或跳帧）也能准时完成动画
+    int hover_dir = hovering ? 1 : (pressing ? 0 : -1); // 按住时移出按钮，悬浮效果保持不变
+    if (hover_dir != ani.hover_direction) // 方向改变，从当前进度开始新的渐变
     {
-        if (hover_progress < 100) // 先判断，再计算，可节约运算资源
-            hover_progress = min((timestamp - hover_timestamp) * 100 / press_bg_duration, 100);
+        ani.hover_direction = hover_dir;
+        ani.hover_from_progress = ani.hover_progress;
+        ani.hover_from_timestamp = timestamp;
     }
-    else // 在框外：变浅
+    int press_dir = pressing ? 1 : -1;
+    if (press_dir != ani.press_direction)
     {
-        if (hover_progress > 0)
-            hover_progress = max((timestamp - leave_timestamp) * 100 / press_bg_duration, 0);
+        ani.press_direction = press_dir;
+        ani.press_from_progress = ani.press_progress;
+        ani.press_from_timestamp = timestamp;
     }
 
-    if (pressing)
-    {
-        if (press_progress < 100)
-            press_progress = min(press_start + (timestamp - press_timestamp) * 100 / press_bg_duration, 100);
-    }
-    else
+    if (ani.press_direction > 0 && ani.press_progress < 100) // 鼠标按下：透明渐变，且没有完成
     {
-        if (press_progress > 0) // 如果按下的效果还在，变浅
-            press_progress = max((timestamp - release_timestamp) * 100 / press_bg_duration, 0);
-    }*/
-
-    if (pressing) // 鼠标按下
-    {
-        if (press_progress < 100) // 透明渐变，且没有完成
-        {
-            press_progress += press_speed;
-            if (press_progress >= 100)
-            {
-                press_progress = 100;
-                if (mouse_press_event)
-                {
-                    emit signalMousePressLater(mouse_press_event);
-                    mouse_press_event = nullptr;
-                }
-            }
-        }
-        if (hovering && hover_progress < 100)
+        ani.press_progress = getTimedProgress(ani.press_from_progress, ani.press_from_timestamp, ani.press_direction, button_style->press_bg_duration, timestamp);
+        if (ani.press_progress >= 100 && mouse_press_event)
         {
-            hover_progress += hover_speed;
-            if (hover_progress >= 100)
-            {
-                hover_progress = 100;
-                emit signalMouseEnterLater();
-            }
+            emit signalMousePressLater(mouse_press_event);
+            mouse_press_event = nullptr;
         }
     }
-    else // 鼠标悬浮
+    else if (ani.press_direction < 0 && ani.press_progress > 0) // 如果按下的效果还在，变浅
     {
-        if (press_progress>0) // 如果按下的效果还在，变浅
+        ani.press_progress = getTimedProgress(ani.press_from_progress, ani.press_from_timestamp, ani.press_direction, button_style->press_bg_duration, timestamp);
+        if (ani.press_progress <= 0 && mouse_release_event)
         {
-            press_progress -= press_speed;
-            if (press_progress <= 0)
-            {
-                press_progress = 0;
-                if (mouse_release_event)
-                {
-                    emit signalMouseReleaseLater(mouse_release_event);
-                    mouse_release_event = nullptr;
-                }
-            }
+            emit signalMouseReleaseLater(mouse_release_event);
+            mouse_release_event = nullptr;
         }
+    }
 
-        if (hovering) // 在框内：加深
-        {
-            if (hover_progress < 100)
-            {
-                hover_progress += hover_speed;
-                if (hover_progress >= 100)
-                {
-                    hover_progress = 100;
-                    emit signalMouseEnterLater();
-                }
-            }
-        }
-        else // 在框外：变浅
-        {
-            if (hover_progress > 0)
-            {
-                hover_progress -= hover_speed;
-                if (hover_progress <= 0)
-                {
-                    hover_progress = 0;
-                    emit signalMouseLeaveLater();
-                }
-            }
-        }
+    if (ani.hover_direction > 0 && ani.hover_progress < 100) // 在框内：加深
+    {
+        ani.hover_progress = getTimedProgress(ani.hover_from_progress, ani.hover_from_timestamp, ani.hover_direction, button_style->hover_bg_duration, timestamp);
+        if (ani.hover_progress >= 100)
+            emit signalMouseEnterLater();
+    }
+    else if (ani.hover_direction < 0 && ani.hover_progress > 0) // 在框外：变浅
+    {
+        ani.hover_progress = getTimedProgress(ani.hover_from_progress, ani.hover_from_timestamp, ani.hover_direction, button_style->hover_bg_duration, timestamp);
+        if (ani.hover_progress <= 0)
+            emit signalMouseLeaveLater();
     }
 
     // ==== 按下背景水波纹动画 ====
@@ -1919,7 +2355,7 @@ void InteractiveButtonBase::anchorTimeOut()
             Water& water = waters[i];
             if (water.finished) // 结束状态
             {
-                water.progress = static_cast<int>(100 - 100 * (timestamp-water.finish_timestamp) / water_finish_duration);
+                water.progress = static_cast<int>(100 - 100 * (timestamp-water.finish_timestamp) / button_style->water_finish_duration);
                 if (water.progress <= 0)
                 {
                     waters.removeAt(i--);
@@ -1945,12 +2381,12 @@ void InteractiveButtonBase::anchorTimeOut()
                 {
                     if (water.release_timestamp) // 鼠标已经松开了
                     {
-                        water.progress = static_cast<int>(100 * (water.release_timestamp - water.press_timestamp) / water_press_duration
-                                + 100 * (timestamp - water.release_timestamp) / water_release_duration);
+                        water.progress = static_cast<int>(100 * (water.release_timestamp - water.press_timestamp) / button_style->water_press_duration
+                                + 100 * (timestamp - water.release_timestamp) / button_style->water_release_duration);
                     }
                     else // 鼠标一直按下
                     {
-                        water.progress = static_cast<int>(100 * (timestamp - water.press_timestamp) / water_press_duration);
+                        water.progress = static_cast<int>(100 * (timestamp - water.press_timestamp) / button_style->water_press_duration);
                     }
                     if (water.progress >= 100)
                     {
@@ -1969,63 +2405,63 @@ void InteractiveButtonBase::anchorTimeOut()
     // ==== 出现动画 ====
     if (show_animation)
     {
-        if (show_ani_appearing) // 出现
+        if (ani.show_ani_appearing) // 出现
         {
-            qint64 delta = getTimestamp() - show_timestamp;
-            if (show_ani_progress >= 100) // 出现结束
+            qint64 delta = timestamp - show_timestamp;
+            if (ani.show_ani_progress >= 100) // 出现结束
             {
-                show_ani_appearing = false;
+                ani.show_ani_appearing = false;
                 emit showAniFinished();
             }
             else
             {
-                show_ani_progress = static_cast<int>(100 * delta / show_duration);
-                if (show_ani_progress > 100)
-                    show_ani_progress = 100;
+                ani.show_ani_progress = static_cast<int>(100 * delta / button_style->show_duration);
+                if (ani.show_ani_progress > 100)
+                    ani.show_ani_progress = 100;
             }
         }
-        if (show_ani_disappearing) // 消失
+        if (ani.show_ani_disappearing) // 消失
         {
-            qint64 delta = getTimestamp() - hide_timestamp;
-            if (show_ani_progress <= 0) // 消失结束
+            qint64 delta = timestamp - hide_timestamp;
+            if (ani.show_ani_progress <= 0) // 消失结束
             {
-                show_ani_disappearing = false;
+                ani.show_ani_disappearing = false;
                 show_foreground = false;
                 show_ani_point = QPoint(0,0);
                 emit hideAniFinished();
             }
             else
             {
-                show_ani_progress = static_cast<int>(100 - 100 * delta / show_duration);
-                if (show_ani_progress < 0)
-                    show_ani_progress = 0;
+                ani.show_ani_progress = static_cast<int>(100 - 100 * delta / button_style->show_duration);
+                if (ani.show_ani_progress < 0)
+                    ani.show_ani_progress = 0;
             }
         }
     }
 
     // ==== 按下动画 ====
-    if (click_ani_disappearing) // 点击动画效果消失
+    if (ani.click_ani_disappearing) // 点击动画效果消失
     {
-        qint64 delta = getTimestamp()-release_timestamp-click_ani_duration;
-        if (delta <= 0) click_ani_progress = 100;
-        else click_ani_progress = static_cast<int>(100 - delta*100 / click_ani_duration);
-        if (click_ani_progress < 0)
+        qint64 delta = timestamp-release_timestamp-button_style->click_ani_duration;
+        if (delta <= 0) ani.click_ani_progress = 100;
+        else ani.click_ani_progress = static_cast<int>(100 - delta*100 / button_style->click_ani_duration);
+        if (ani.click_ani_progress < 0)
         {
-            click_ani_progress = 0;
-            click_ani_disappearing = false;
+            ani.click_ani_progress = 0;
+            ani.click_ani_disappearing = false;
             emit pressAppearAniFinished();
         }
     }
-    if (click_ani_appearing) // 点击动画效果
+    if (ani.click_ani_appearing) // 点击动画效果
     {
-        qint64 delta = getTimestamp()-release_timestamp;
-        if (delta <= 0) click_ani_progress = 0;
-        else click_ani_progress = static_cast<int>(delta * 100 / click_ani_duration);
-        if (click_ani_progress > 100)
+        qint64 delta = timestamp-release_timestamp;
+        if (delta <= 0) ani.click_ani_progress = 0;
+        else ani.click_ani_progress = static_cast<int>(delta * 100 / button_style->click_ani_duration);
+        if (ani.click_ani_progress > 100)
         {
-            click_ani_progress = 100; // 保持100的状态，下次点击时回到0
-            click_ani_appearing = false;
-            click_ani_disappearing = true;
+            ani.click_ani_progress = 100; // 保持100的状态，下次点击时回到0
+            ani.click_ani_appearing = false;
+            ani.click_ani_disappearing = true;
             emit pressDisappearAniFinished();
         }
     }
@@ -2036,10 +2472,10 @@ void InteractiveButtonBase::anchorTimeOut()
         // 当前应该是处在最后一个点
         Jitter cur = jitters.first();
         Jitter aim = jitters.at(1);
-        int del = static_cast<int>(getTimestamp()-cur.timestamp);
+        int del = static_cast<int>(timestamp-cur.timestamp);
         int dur = static_cast<int>(aim.timestamp - cur.timestamp);
-        effect_pos = cur.point + (aim.point-cur.point)*del/dur;
-        offset_pos = effect_pos- (geometry().center() - geometry().topLeft());
+        ani.effect_pos = cur.point + (aim.point-cur.point)*del/dur;
+        ani.offset_pos = ani.effect_pos- (geometry().center() - geometry().topLeft());
 
         if (del >= dur)
             jitters.removeFirst();
@@ -2051,24 +2487,24 @@ void InteractiveButtonBase::anchorTimeOut()
             emit jitterAniFinished();
         }
     }
-    else if (anchor_pos != mouse_pos) // 移动效果
+    else if (ani.anchor_pos != mouse_pos) // 移动效果
     {
-        int delta_x = anchor_pos.x() - mouse_pos.x(),
-            delta_y = anchor_pos.y() - mouse_pos.y();
+        int delta_x = ani.anchor_pos.x() - mouse_pos.x(),
+            delta_y = ani.anchor_pos.y() - mouse_pos.y();
 
-        anchor_pos.setX( anchor_pos.x() - quick_sqrt(delta_x) );
-        anchor_pos.setY( anchor_pos.y() - quick_sqrt(delta_y) );
+        ani.anchor_pos.setX( ani.anchor_pos.x() - quick_sqrt(delta_x) );
+        ani.anchor_pos.setY( ani.anchor_pos.y() - quick_sqrt(delta_y) );
 
-        offset_pos.setX(quick_sqrt(static_cast<long>(anchor_pos.x()-(geometry().width()>>1))));
-        offset_pos.setY(quick_sqrt(static_cast<long>(anchor_pos.y()-(geometry().height()>>1))));
-        effect_pos.setX( (geometry().width() >>1) + offset_pos.x());
-        effect_pos.setY( (geometry().height()>>1) + offset_pos.y());
+        ani.offset_pos.setX(quick_sqrt(static_cast<long>(ani.anchor_pos.x()-(geometry().width()>>1))));
+        ani.offset_pos.setY(quick_sqrt(static_cast<long>(ani.anchor_pos.y()-(geometry().height()>>1))));
+        ani.effect_pos.setX( (geometry().width() >>1) + ani.offset_pos.x());
+        ani.effect_pos.setY( (geometry().height()>>1) + ani.offset_pos.y());
     }
-    else if (!pressing && !hovering && !hover_progress && !press_progress
-             && !click_ani_appearing && !click_ani_disappearing && !jitters.size() && !waters.size()
-             && !show_ani_appearing && !show_ani_disappearing) // 没有需要加载的项，暂停（节约资源）
+    else if (!pressing && !hovering && !ani.hover_progress && !ani.press_progress
+             && !ani.click_ani_appearing && !ani.click_ani_disappearing && !jitters.size() && !waters.size()
+             && !ani.show_ani_appearing && !ani.show_ani_disappearing) // 没有需要加载的项，暂停（节约资源）
     {
-        anchor_timer->stop();
+        stopAnimation();
     }
 
     // ==== 统一坐标的出现动画 ====
@@ -2077,7 +2513,72 @@ void InteractiveButtonBase::anchorTimeOut()
         updateUnifiedGeometry();
     }
 
-    update();
+    // 只重绘变化的区域
+    QRegion dirty = getDirtyRegion();
+    if (!dirty.isEmpty())
+        update(dirty);
+    saveDirtyState();
+}
+
+/**
+ * 批量创建时设置内容
+ * 直接写入成员，不经过 setText/setIcon 等逐个重新计算度量、刷新
+ * @param descriptor   内容和位置
+ * @param style        共用的样式
+ * @param line_spacing 批量计算好的行高（图标+文字模式的图标大小）
+ */
+void InteractiveButtonBase::applyDescriptor(const ButtonDescriptor &descriptor, const InteractiveButtonStyle &style, int line_spacing)
+{
+    button_style = style;
+    text = descriptor.text;
+    icon = descriptor.icon;
+    pixmap = descriptor.pixmap;
+
+    if (!pixmap.isNull())
+        model = text.isEmpty() ? PaintModel::PixmapMask : PaintModel::PixmapText;
+    else if (!icon.isNull())
+        model = text.isEmpty() ? PaintModel::Icon : PaintModel::IconText;
+    else
+        model = text.isEmpty() ? PaintModel::None : PaintModel::Text;
+    if (model == PaintModel::IconText || model == PaintModel::PixmapText)
+    {
+        align = Qt::AlignLeft | Qt::AlignVCenter;
+        icon_text_size = line_spacing;
+    }
+
+    if (descriptor.geometry.isValid())
+        setGeometry(descriptor.geometry);
+}
+
+/**
+ * 开始等待第二次单击
+ * 双击时钟只在等待期间存在，大量开启双击的按钮平时不占用定时器
+ */
+void InteractiveButtonBase::startDoubleTimer()
+{
+    if (double_timer == nullptr)
+    {
+        double_timer = new QTimer(this);
+        double_timer->setSingleShot(true);
+        double_timer->setInterval(DOUBLE_PRESS_INTERVAL);
+        connect(double_timer, &QTimer::timeout, this, [=]{
+            stopDoubleTimer();
+            emit clicked(); // 手动触发单击事件
+        });
+    }
+    double_timer->start();
+}
+
+/**
+ * 结束等待，释放双击时钟
+ */
+void InteractiveButtonBase::stopDoubleTimer()
+{
+    if (double_timer == nullptr)
+        return ;
+    double_timer->stop();
+    double_timer->deleteLater();
+    double_timer = nullptr;
 }
 
 /**
@@ -2086,10 +2587,10 @@ void InteractiveButtonBase::anchorTimeOut()
  */
 void InteractiveButtonBase::slotClicked()
 {
-    click_ani_appearing = true;
-    click_ani_disappearing = false;
-    click_ani_progress = 0;
-    release_offset = offset_pos;
+    ani.click_ani_appearing = true;
+    ani.click_ani_disappearing = false;
+    ani.click_ani_progress = 0;
+    release_offset = ani.offset_pos;
 
     jitters.clear(); // 清除抖动
 }
@@ -10,16 +10,23 @@
 #include <QMouseEvent>
 #include <QPainter>
 #include <QDebug>
-#include <QDateTime>
 #include <QList>
 #include <QBitmap>
+#include <QStaticText>
 #include <QtMath>
+#include "buttonanimationdriver.h"
+#include "buttonprofiler.h"
+#include "ringqueue.h"
+#include "interactivebuttonstyle.h"
+#include "easingtable.h"
 
 #define PI 3.1415926
 #define GOLDEN_RATIO 0.618
 
 #define DOUBLE_PRESS_INTERVAL 500 // /* 300 */松开和按下的间隔。相等为双击
 #define SINGLE_PRESS_INTERVAL 200 // /* 150 */按下时间超过这个数就是单击。相等为单击
+#define DEFAULT_WATER_CAPACITY 8  // 同时存在的水波纹数量上限
+#define PIXMAP_SIZE_BUCKET 4      // 着色图标缓存的尺寸粒度（像素），动画中尺寸连续变化也能命中缓存
 
 /**
  * Copyright (c) 2019 命燃芯乂 All rights reserved.
@@ -35,7 +42,7 @@
  * 程序版权归作者所有，只可使用不能出售，违反者本人有权追究责任。
  */
 
-class InteractiveButtonBase : public QPushButton
+class InteractiveButtonBase : public QPushButton, public AnimationTarget
 {
     Q_OBJECT
     Q_PROPERTY(bool self_enabled READ getSelfEnabled WRITE setSelfEnabled)                      // 是否启用自定义的按钮（true）
@@ -78,7 +85,7 @@ public:
         None,       // 无前景，仅使用背景
         Text,       // 纯文字（替代父类）
         Icon,       // 纯图标
-        PixmapMask, // 可变色图标（通过pixmap+遮罩实现），锯齿化明显
+        PixmapMask, // 可变色图标（按 pixmap 透明度着色，保留抗锯齿边缘）
         IconText,   // 图标+文字（强制左对齐）
         PixmapText  // 变色图标+文字（强制左对齐）
     };
@@ -98,6 +105,54 @@ public:
         QSize size;          // 固定大小
     };
 
+    /**
+     * 上一次绘制使用的着色图标
+     * 参数不变时直接复用，不必每帧查询全局缓存
+     */
+    struct TintedPixmap
+    {
+        TintedPixmap() : source_key(0), color(0), dpr(0) {}
+        qint64 source_key; // 原图标 cacheKey
+        QRgb color;        // 着色
+        QSize size;        // 取整后的尺寸
+        qreal dpr;         // 设备像素比
+        QPixmap pixmap;    // 着色并缩放后的图标
+    };
+
+    /**
+     * 排版好的文字
+     * 文字、字体不变时只移动绘制位置，不重新排版
+     */
+    struct TextLayout
+    {
+        TextLayout() : font_revision(-1) {}
+        QString text;            // 排版时的文字
+        int font_revision;       // 排版时的字体版本
+        QStaticText static_text; // 排版结果
+    };
+
+    /**
+     * 前景图层缓存
+     * 记录绘制时的内容、颜色、尺寸，任意一项改变则重新绘制
+     */
+    struct ForeLayer
+    {
+        ForeLayer() : dpr(0), model(None), align(0), font_revision(-1), text_color(0), icon_color(0),
+                      icon_key(0), icon_mode(0), icon_size(0), pixmap_key(0) {}
+        QPixmap pixmap; // 前景图层
+        QSize size;
+        qreal dpr;
+        PaintModel model;
+        int align;
+        QString text;
+        int font_revision;
+        QRgb text_color, icon_color;
+        qint64 icon_key;
+        int icon_mode;
+        int icon_size;
+        qint64 pixmap_key;
+    };
+
     /**
      * 鼠标松开时抖动动画
      * 松开的时候计算每一次抖动距离+时间，放入队列中
@@ -117,6 +172,7 @@ public:
      */
     struct Water
     {
+        Water() : Water(QPoint(), 0) {}
         Water(QPoint p, qint64 t) : point(p), progress(0), press_timestamp(t),
                                     release_timestamp(0), finish_timestamp(0), finished(false) {}
         QPoint point;
@@ -127,17 +183,57 @@ public:
         bool finished;            // 是否结束。结束后改为渐变消失
     };
 
+    /**
+     * 每一帧都要读写的动画状态
+     * 集中在一块（64字节，一个缓存行大小），与很少改动的配置分开
+     * 刷新一帧时只需要访问这一块内存
+     */
+    struct AnimationState
+    {
+        AnimationState() : hover_from_timestamp(0), press_from_timestamp(0),
+                           anchor_pos(-1, -1), offset_pos(0, 0), effect_pos(-1, -1),
+                           hover_progress(0), press_progress(0), click_ani_progress(0), show_ani_progress(0),
+                           hover_from_progress(0), press_from_progress(0), hover_direction(-1), press_direction(-1),
+                           click_ani_appearing(false), click_ani_disappearing(false),
+                           show_ani_appearing(false), show_ani_disappearing(false) {}
+        qint64 hover_from_timestamp, press_from_timestamp; // 本次渐变开始的时间戳
+        QPoint anchor_pos;                                 // 目标锚点，渐渐靠近鼠标
+        QPoint offset_pos;                                 // 当前偏移量（相对中心）
+        QPoint effect_pos;                                 // 影响位置（相对左上角）
+        int hover_progress, press_progress;                // 颜色渐变进度
+        int click_ani_progress;                            // 按下的进度（使用时间差计算）
+        int show_ani_progress;                             // 出现动画的进度
+        qint8 hover_from_progress, press_from_progress;    // 本次渐变开始时的进度（0~100）
+        qint8 hover_direction, press_direction;            // 颜色渐变方向：1加深、-1变浅、0不变
+        bool click_ani_appearing, click_ani_disappearing;  // 是否正在按下的动画效果中
+        bool show_ani_appearing, show_ani_disappearing;    // 是否正在出现/消失的动画效果中
+    };
+
     /**
      * 四周边界的padding
      * 调整按钮大小时：宽度+左右、高度+上下
      */
-    struct EdgeVal
+    typedef InteractiveButtonStyle::EdgeVal EdgeVal;
+
+    /**
+     * 批量创建按钮时每个按钮的内容
+     * 文字、图标、可变色图标可以任意组合，规则与 setText/setIcon/setPixmap 相同
+     */
+    struct ButtonDescriptor
     {
-        EdgeVal() {}
-        EdgeVal(int l, int t, int r, int b) : left(l), top(t), right(r), bottom(b) {}
-        int left, top, right, bottom; // 四个边界的空白距离
+        ButtonDescriptor() {}
+        ButtonDescriptor(QString t, QRect g = QRect()) : text(t), geometry(g) {}
+        ButtonDescriptor(QIcon i, QRect g = QRect()) : icon(i), geometry(g) {}
+        ButtonDescriptor(QPixmap p, QRect g = QRect()) : pixmap(p), geometry(g) {}
+        QString text;
+        QIcon icon;
+        QPixmap pixmap;
+        QRect geometry; // 无效则不设置位置
     };
 
+    template<typename T = InteractiveButtonBase>
+    static QList<T*> createButtons(const QList<ButtonDescriptor>& descriptors, const InteractiveButtonStyle& style, QWidget* parent);
+
     enum NolinearType
     {
         Linear,
@@ -145,8 +241,13 @@ public:
         FastSlower,
         SlowFastSlower,
         SpringBack20,
-        SpringBack50
+        SpringBack50,
+        EaseInOut,    // cubic-bezier(0.42, 0, 0.58, 1)
+        SpringDamped  // 阻尼弹簧，在终点附近衰减振动
     };
+    static const EasingTable& getEasingTable(NolinearType type);
+    static int getTimedProgress(int from, qint64 from_timestamp, int direction, int duration, qint64 timestamp);
+    static QColor getOpacityColor(QColor color, double level = 0.5);
 
     virtual void setText(QString text);
     virtual void setIconPath(QString path);
@@ -163,7 +264,11 @@ public:
     void setPressAniDuration(int d);
     void setClickAniDuration(int d);
     void setWaterAniDuration(int press, int release, int finish);
+    void setHoverEasing(const EasingTable& easing);
+    void setWaterEasing(const EasingTable& easing);
     void setWaterRipple(bool enable = true);
+    void setWaterCapacity(int capacity);
+    void setForeLayerCache(bool enable = true);
     void setJitterAni(bool enable = true);
     void setUnifyGeomerey(bool enable = true);
     void setBgColor(QColor bg);
@@ -196,6 +301,7 @@ public:
     void setAutoTextColor(bool a = true);
     void setPretendFocus(bool f = true);
     void setBlockHover(bool b = true);
+    void setButtonStyle(const InteractiveButtonStyle& style);
 
     void setShowAni(bool enable = true);
     void showForeground();
@@ -212,29 +318,34 @@ public:
     bool isPressing() { return pressing; }
     void simulateHover();
     void discardHoverPress(bool force = false);
+    virtual void resetAnimationState();
 
     bool getSelfEnabled() { return self_enabled; }
     bool getParentEnabled() { return parent_enabled; }
     bool getForeEnabled() { return fore_enabled; }
-    QColor getIconColor() { return icon_color; }
-    QColor getTextColor() { return text_color; }
-    QColor getNormalColor() { return normal_bg; }
-    QColor getBorderColor() { return border_bg; }
-    QColor getHoverColor() { return hover_bg; }
-    QColor getPressColor() { return press_bg; }
+    QColor getIconColor() { return button_style->icon_color; }
+    QColor getTextColor() { return button_style->text_color; }
+    QColor getNormalColor() { return button_style->normal_bg; }
+    QColor getBorderColor() { return button_style->border_bg; }
+    QColor getHoverColor() { return button_style->hover_bg; }
+    QColor getPressColor() { return button_style->press_bg; }
     QString getIconPath() { return ""; }
     QString getPixmapPath() { return ""; }
-    int getHoverAniDuration() { return hover_bg_duration; }
-    int getPressAniDuration() { return press_bg_duration; }
-    int getClickAniDuration() { return click_ani_duration; }
-    double getIconPaddingProper() { return icon_padding_proper; }
-    int getRadius() { return qMax(radius_x, radius_y); }
-    int getBorderWidth() { return border_width; }
+    int getHoverAniDuration() { return button_style->hover_bg_duration; }
+    int getPressAniDuration() { return button_style->press_bg_duration; }
+    int getClickAniDuration() { return button_style->click_ani_duration; }
+    double getIconPaddingProper() { return button_style->icon_padding_proper; }
+    int getRadius() { return qMax(button_style->radius_x, button_style->radius_y); }
+    int getBorderWidth() { return button_style->border_width; }
     bool getFixedTextPos() { return fixed_fore_pos; }
     bool getTextDynamicSize() { return text_dynamic_size; }
     bool getLeaveAfterClick() { return leave_after_clicked; }
     bool getShowAni() { return show_animation; }
     bool getWaterRipple() { return water_animation; }
+    int getWaterCapacity() { return waters.capacity(); }
+    bool getForeLayerCache() { return fore_layer_cache; }
+    InteractiveButtonStyle getButtonStyle() { return button_style; }
+    const AnimationState& getAnimationState() const { return ani; }
 
 #if QT_DEPRECATED_SINCE(5, 11)
     QT_DEPRECATED_X("Use InteractiveButtonBase::setFixedForePos(bool fixed = true)")
@@ -242,6 +353,7 @@ public:
 #endif
 
 protected:
+    bool event(QEvent *event) override;
     void enterEvent(QEvent *event) override;
     void leaveEvent(QEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
@@ -255,27 +367,51 @@ protected:
 
     virtual bool inArea(QPoint point);
     virtual QPainterPath getBgPainterPath();
-    virtual QPainterPath getWaterPainterPath(Water water);
+    virtual bool isBgPainterPathCacheable();
+    virtual qint64 getBgPainterPathKey();
+    QPainterPath getCachedBgPainterPath();
+    void invalidateBgPainterPath();
+    virtual QRegion getDirtyRegion();
     virtual void drawIconBeforeText(QPainter &painter, QRect icon_rect);
 
     QRect getUnifiedGeometry();
     void updateUnifiedGeometry();
-    void paintWaterRipple(QPainter &painter);
+    void paintWaterRipple(QPainter &painter, const QPainterPath& path_back);
+    virtual QRect getWaterRect(const Water &water);
+    QRect getForegroundDirtyRect();
+    void saveDirtyState();
     void setJitter();
+    void startDoubleTimer();
+    void stopDoubleTimer();
+    void applyDescriptor(const ButtonDescriptor& descriptor, const InteractiveButtonStyle& style, int line_spacing);
+
+    void startAnimation();
+    void stopAnimation();
+    bool isAnimating();
+    void animationTick() override;
+    QScreen* animationScreen() override;
 
     int getFontSizeT();
     void setFontSizeT(int f);
 
     int max(int a, int b) const;
     int min(int a, int b) const;
+    EdgeVal getForePaddings() const;
     int quick_sqrt(long X) const;
     qint64 getTimestamp() const;
     bool isLightColor(QColor color);
     int getSpringBackProgress(int x, int max);
-    QColor getOpacityColor(QColor color, double level = 0.5);
     QPixmap getMaskPixmap(QPixmap p, QColor c);
+    QPixmap getTintedPixmap(const QPixmap& p, QColor c, QSize size, qreal dpr);
+    const QPixmap& getTintedPixmap(TintedPixmap& tinted, const QPixmap& p, QColor c, QSize size, qreal dpr);
+    QColor getIconPaintColor();
+    const QFont& getPaintFont();
+    void drawForeText(QPainter& painter, QRect rect, int flags, const QString& text);
+    void paintForeground(QPainter& painter, QRect rect, bool layered = false);
+    void paintForeLayer(QPainter& painter, QRect rect);
 
     double getNolinearProg(int p, NolinearType type);
+    double getNolinearProg(int p, const EasingTable& table);
     QIcon::Mode getIconMode();
 
 signals:
@@ -304,12 +440,14 @@ public slots:
     void slotCloseState();
 
 protected:
+    AnimationState ani; // 每帧读写的状态放在最前面，紧挨着对象头
     PaintModel model;
     QIcon icon;
     QString text;
-    QPixmap pixmap;
-    PaintAddin paint_addin;
-    EdgeVal fore_paddings;
+    QPixmap pixmap;         // 原始图标（未着色），绘制时从缓存取对应颜色、尺寸的图标
+    PaintAddin paint_addin; // 同上，角标也保存原始图标
+    TintedPixmap tinted_pixmap, tinted_addin;
+    InteractiveButtonStyle button_style; // 颜色、时长、圆角、留白等配置，同样式的按钮共用一份
 
 protected:
     // 总体开关
@@ -317,36 +455,31 @@ protected:
 
     // 出现前景的动画
     bool show_animation, show_foreground;
-    bool show_ani_appearing, show_ani_disappearing;
-    int show_duration;
     qint64 show_timestamp, hide_timestamp;
-    int show_ani_progress;
     QPoint show_ani_point;
     QRect paint_rect;
 
     // 鼠标开始悬浮、按下、松开、离开的坐标和时间戳
-    // 鼠标锚点、目标锚点、当前锚点的坐标；当前XY的偏移量
-    QPoint enter_pos, press_pos, release_pos, mouse_pos, anchor_pos /*目标锚点渐渐靠近鼠标*/;
-    QPoint offset_pos /*当前偏移量*/, effect_pos, release_offset;                // 相对中心、相对左上角、弹起时的平方根偏移
+    // 目标锚点、当前偏移量等每帧变化的见 ani
+    QPoint enter_pos, press_pos, release_pos, mouse_pos;
+    QPoint release_offset;                                                       // 弹起时的平方根偏移
     bool hovering, pressing;                                                     // 是否悬浮和按下的状态机
     qint64 hover_timestamp, leave_timestamp, press_timestamp, release_timestamp; // 各种事件的时间戳
-    int hover_bg_duration, press_bg_duration, click_ani_duration;                // 各种动画时长
-
-    // 定时刷新界面（保证动画持续）
-    QTimer *anchor_timer;
-    int move_speed;
 
     // 背景与前景
-    QColor icon_color, text_color;                   // 前景颜色
-    QColor normal_bg, hover_bg, press_bg, border_bg; // 各种背景颜色
-    QColor focus_bg, focus_border;                   // 有焦点的颜色
-    int hover_speed, press_start, press_speed;       // 颜色渐变速度
-    int hover_progress, press_progress;              // 颜色渐变进度
-    double icon_padding_proper;                      // 图标的大小比例
-    int icon_text_padding, icon_text_size;           // 图标+文字模式共存时，两者间隔、图标大小
-    int border_width;
-    int radius_x, radius_y;
+    int icon_text_size;                              // 图标+文字模式共存时，图标大小
+    QPainterPath bg_path_cache;                           // 背景形状缓存（路径运算开销大）
+    bool bg_path_valid;                                   // 缓存是否有效
+    QSize bg_path_size;                                   // 缓存时的尺寸
+    int bg_path_radius_x, bg_path_radius_y;               // 缓存时的圆角
+    qint64 bg_path_key;                                   // 缓存时子类的形状参数
     int font_size;
+    QFont paint_font;         // 绘制文字的字体（font() + font_size），字体改变时更新
+    bool paint_font_valid;    // 字体缓存是否有效
+    int paint_font_revision;  // 字体版本，用来判断文字排版是否过期
+    TextLayout text_layout;   // 前景文字排版缓存
+    bool fore_layer_cache;    // 是否使用前景图层缓存（动画时只平移、缩放）
+    ForeLayer fore_layer;
     bool fixed_fore_pos;    // 鼠标进入时是否固定文字位置
     bool fixed_fore_size;   // 鼠标进入/点击时是否固定前景大小
     bool text_dynamic_size; // 设置字体时自动调整最小宽高
@@ -354,8 +487,6 @@ protected:
     bool focusing;          // 是否获得了焦点
 
     // 鼠标单击动画
-    bool click_ani_appearing, click_ani_disappearing; // 是否正在按下的动画效果中
-    int click_ani_progress;                           // 按下的进度（使用时间差计算）
     QMouseEvent *mouse_press_event, *mouse_release_event;
 
     // 统一绘制图标的区域（从整个按钮变为中心三分之二，并且根据偏移计算）
@@ -364,16 +495,21 @@ protected:
 
     // 鼠标拖拽弹起来回抖动效果
     bool jitter_animation;      // 是否开启鼠标松开时的抖动效果
-    double elastic_coefficient; // 弹性系数
     QList<Jitter> jitters;
-    int jitter_duration; // 抖动一次，多次效果叠加
 
     // 鼠标按下水波纹动画效果
     bool water_animation; // 是否开启水波纹动画
-    QList<Water> waters;
-    int water_press_duration, water_release_duration, water_finish_duration;
+    RingQueue<Water> waters; // 固定容量，快速连点时丢弃最旧的水波纹
     int water_radius;
 
+    // 局部刷新：上一帧的动画状态，对比后只重绘变化的区域
+    int last_hover_progress, last_press_progress, last_click_ani_progress, last_show_ani_progress;
+    bool last_click_ani_appearing, last_click_ani_disappearing;
+    bool last_show_ani_appearing, last_show_ani_disappearing, last_show_foreground;
+    QPoint last_offset_pos;
+    QRect last_water_rect;    // 上一帧正在扩散的水波纹范围
+    bool last_water_finished; // 上一帧是否有渐变消失的水波纹（覆盖整个背景）
+
     // 其他效果
     Qt::Alignment align;      // 文字/图标对其方向
     bool _state;              // 一个记录状态的变量，比如是否持续
@@ -382,8 +518,45 @@ protected:
 
     // 双击
     bool double_clicked;  // 开启双击
-    QTimer *double_timer; // 双击时钟
+    QTimer *double_timer; // 双击时钟（等待第二次单击时才创建）
     bool double_prevent;  // 双击阻止单击release的flag
 };
 
+/**
+ * 批量创建按钮
+ * 所有按钮共用同一个样式；文字度量只计算一次；父控件暂停刷新，全部创建完后统一绘制一次
+ * 适合一次创建成百上千个按钮的列表、面板
+ * @param descriptors 每个按钮的内容和位置
+ * @param style       共用的样式（会替换子类构造时设置的样式）
+ * @param parent      父控件
+ * @return            创建的按钮，顺序与 descriptors 相同
+ */
+template<typename T>
+QList<T*> InteractiveButtonBase::createButtons(const QList<ButtonDescriptor>& descriptors, const InteractiveButtonStyle& style, QWidget* parent)
+{
+    QList<T*> buttons;
+    buttons.reserve(descriptors.size());
+    bool pause_updates = parent && parent->updatesEnabled();
+    if (pause_updates)
+        parent->setUpdatesEnabled(false);
+
+    int line_spacing = QFontMetrics(parent ? parent->font() : QApplication::font()).lineSpacing();
+    foreach (const ButtonDescriptor& descriptor, descriptors)
+    {
+        T* btn = new T(parent);
+        static_cast<InteractiveButtonBase*>(btn)->applyDescriptor(descriptor, style, line_spacing);
+        buttons.append(btn);
+    }
+
+    // 父控件已经显示时，后创建的子控件需要手动显示
+    if (parent && parent->isVisible())
+    {
+        foreach (T* btn, buttons)
+            btn->show();
+    }
+    if (pause_updates)
+        parent->setUpdatesEnabled(true);
+    return buttons;
+}
+
 #endif // INTERACTIVEBUTTONBASE_H
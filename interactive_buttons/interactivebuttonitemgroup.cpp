@@ -0,0 +1,599 @@
+#include "interactivebuttonitemgroup.h"
+#include <QWindow>
+
+InteractiveButtonItem::InteractiveButtonItem(QString text, QRect geometry)
+    : geometry(geometry), text(text), enabled(true), hovering(false), pressing(false),
+      hover_progress(0), hover_level(0), hover_direction(-1), hover_from_progress(0), hover_from_timestamp(0),
+      waters(DEFAULT_WATER_CAPACITY), group(nullptr), active(false), bg_path_valid(false), static_text_valid(false)
+{
+}
+
+InteractiveButtonItem::InteractiveButtonItem(QIcon icon, QRect geometry) : InteractiveButtonItem("", geometry)
+{
+    this->icon = icon;
+}
+
+/**
+ * 从容器中析构时，容器已经移除了对它的引用
+ */
+InteractiveButtonItem::~InteractiveButtonItem()
+{
+}
+
+void InteractiveButtonItem::setGeometry(QRect geometry)
+{
+    update(); // 旧的位置
+    if (this->geometry.size() != geometry.size())
+        bg_path_valid = false;
+    this->geometry = geometry;
+    update();
+}
+
+void InteractiveButtonItem::setText(QString text)
+{
+    this->text = text;
+    static_text_valid = false;
+    update();
+}
+
+void InteractiveButtonItem::setIcon(QIcon icon)
+{
+    this->icon = icon;
+    update();
+}
+
+/**
+ * 设置悬浮、按下的背景颜色
+ */
+void InteractiveButtonItem::setBgColor(QColor hover, QColor press)
+{
+    button_style.setHoverColor(hover);
+    button_style.setPressColor(press);
+    update();
+}
+
+void InteractiveButtonItem::setNormalColor(QColor color)
+{
+    button_style.setNormalColor(color);
+    update();
+}
+
+void InteractiveButtonItem::setTextColor(QColor color)
+{
+    button_style.setTextColor(color);
+    update();
+}
+
+void InteractiveButtonItem::setRadius(int radius)
+{
+    button_style.setRadius(radius, radius);
+    bg_path_valid = false;
+    update();
+}
+
+void InteractiveButtonItem::setHoverAniDuration(int d)
+{
+    button_style.setHoverAniDuration(d);
+}
+
+void InteractiveButtonItem::setWaterAniDuration(int press, int release, int finish)
+{
+    button_style.setWaterAniDuration(press, release, finish);
+}
+
+/**
+ * 悬浮渐变的缓动曲线，下一帧生效
+ */
+void InteractiveButtonItem::setHoverEasing(const EasingTable &easing)
+{
+    button_style.setHoverEasing(easing);
+    startAnimation();
+}
+
+void InteractiveButtonItem::setWaterEasing(const EasingTable &easing)
+{
+    button_style.setWaterEasing(easing);
+}
+
+/**
+ * 整体设置样式，可与 InteractiveButtonBase 共用同一个样式
+ */
+void InteractiveButtonItem::setButtonStyle(const InteractiveButtonStyle &style)
+{
+    if (button_style.isSharedWith(style))
+        return ;
+    button_style = style;
+    bg_path_valid = false;
+    update();
+}
+
+/**
+ * 不可用时半透明，不响应鼠标
+ * 容器同时放弃对它的悬浮、按下记录
+ */
+void InteractiveButtonItem::setEnabled(bool enable)
+{
+    if (enabled == enable)
+        return ;
+    enabled = enable;
+    if (!enable && group)
+        group->disableItem(this);
+    update();
+}
+
+/**
+ * 判断坐标是否在按钮项内
+ * 子类异形按钮重写
+ * @param  point 相对于按钮项左上角的坐标
+ * @return       是否在区域内
+ */
+bool InteractiveButtonItem::inArea(QPoint point) const
+{
+    if (!button_style->radius_x && !button_style->radius_y)
+        return QRect(QPoint(0, 0), geometry.size()).contains(point);
+    return getCachedBgPainterPath().contains(point);
+}
+
+/**
+ * 背景形状（相对于按钮项左上角）
+ */
+QPainterPath InteractiveButtonItem::getBgPainterPath() const
+{
+    QPainterPath path;
+    if (button_style->radius_x || button_style->radius_y)
+        path.addRoundedRect(QRectF(QPoint(0, 0), geometry.size()), button_style->radius_x, button_style->radius_y);
+    else
+        path.addRect(QRectF(QPoint(0, 0), geometry.size()));
+    return path;
+}
+
+/**
+ * 背景形状缓存，尺寸、圆角变化时重新计算
+ */
+const QPainterPath &InteractiveButtonItem::getCachedBgPainterPath() const
+{
+    if (!bg_path_valid)
+    {
+        bg_path = getBgPainterPath();
+        bg_path_valid = true;
+    }
+    return bg_path;
+}
+
+/**
+ * 绘制按钮项
+ * painter 已经平移到按钮项的左上角
+ */
+void InteractiveButtonItem::paint(QPainter &painter)
+{
+    const QPainterPath& path_back = getCachedBgPainterPath();
+    QRect rect(QPoint(0, 0), geometry.size());
+    if (!enabled)
+        painter.setOpacity(0.5);
+
+    // ==== 背景 ====
+    if (button_style->normal_bg.alpha() != 0)
+        painter.fillPath(path_back, button_style->normal_bg);
+    if (hover_level > 0)
+        painter.fillPath(path_back, InteractiveButtonBase::getOpacityColor(button_style->hover_bg, hover_level));
+    if (waters.size())
+    {
+        painter.save();
+        painter.setClipPath(path_back, Qt::IntersectClip);
+        painter.setPen(Qt::NoPen);
+        int water_radius = static_cast<int>(qMax(rect.width(), rect.height()) * 1.42);
+        const EasingTable& water_easing = button_style->water_easing;
+        for (int i = 0; i < waters.size(); i++)
+        {
+            const InteractiveButtonBase::Water& water = waters.at(i);
+            if (water.finished) // 渐变消失
+            {
+                painter.fillRect(rect, InteractiveButtonBase::getOpacityColor(button_style->press_bg, water.progress / 100.0));
+            }
+            else // 圆形出现，与 InteractiveButtonBase::getWaterRect 相同的曲线
+            {
+                int ra = static_cast<int>(water_radius * water_easing.valueAt(water.progress));
+                painter.setBrush(button_style->press_bg);
+                painter.drawEllipse(water.point, ra, ra);
+            }
+        }
+        painter.restore();
+    }
+
+    // ==== 前景 ====
+    if (!icon.isNull())
+    {
+        const InteractiveButtonStyle::EdgeVal& paddings = button_style->fore_paddings;
+        QRect icon_rect = text.isEmpty() ? rect.adjusted(paddings.left, paddings.top, -paddings.right, -paddings.bottom)
+                                         : QRect(paddings.left, (rect.height() - 16) / 2, 16, 16);
+        icon.paint(&painter, icon_rect, Qt::AlignCenter, enabled ? QIcon::Normal : QIcon::Disabled);
+    }
+    if (!text.isEmpty())
+    {
+        if (!static_text_valid)
+        {
+            static_text.setText(text);
+            static_text.setTextFormat(Qt::PlainText);
+            static_text.setPerformanceHint(QStaticText::AggressiveCaching);
+            static_text.prepare(QTransform(), painter.font());
+            static_text_valid = true;
+        }
+        QSizeF size = static_text.size();
+        painter.setPen(button_style->text_color);
+        painter.drawStaticText(QPointF((rect.width() - size.width()) / 2, (rect.height() - size.height()) / 2), static_text);
+    }
+
+    if (!enabled)
+        painter.setOpacity(1);
+}
+
+/**
+ * 刷新一帧动画
+ * @param  timestamp 本帧时间戳
+ * @return           是否还需要继续刷新
+ */
+bool InteractiveButtonItem::animate(qint64 timestamp)
+{
+    // ==== 悬浮渐变 ====
+    int aim = hover_direction > 0 ? 100 : 0;
+    if (hover_progress != aim)
+        hover_progress = InteractiveButtonBase::getTimedProgress(hover_from_progress, hover_from_timestamp, hover_direction,
+                                                                 button_style->hover_bg_duration, timestamp);
+
+    // ==== 水波纹 ====
+    for (int i = 0; i < waters.size(); i++)
+    {
+        InteractiveButtonBase::Water& water = waters[i];
+        if (water.finished) // 渐变消失
+        {
+            water.progress = static_cast<int>(100 - 100 * (timestamp - water.finish_timestamp) / button_style->water_finish_duration);
+            if (water.progress <= 0)
+                waters.removeAt(i--);
+        }
+        else if (water.progress >= 100) // 满了
+        {
+            if (water.release_timestamp) // 鼠标已经松开了
+            {
+                water.finished = true;
+                water.finish_timestamp = timestamp;
+            }
+        }
+        else // 扩散中
+        {
+            if (water.release_timestamp)
+                water.progress = static_cast<int>(100 * (water.release_timestamp - water.press_timestamp) / button_style->water_press_duration
+                                                  + 100 * (timestamp - water.release_timestamp) / button_style->water_release_duration);
+            else
+                water.progress = static_cast<int>(100 * (timestamp - water.press_timestamp) / button_style->water_press_duration);
+            water.progress = qMin(water.progress, 100);
+        }
+    }
+
+    return hover_progress != aim || waters.size();
+}
+
+void InteractiveButtonItem::enter(qint64 timestamp)
+{
+    hovering = true;
+    hover_from_progress = hover_progress;
+    hover_from_timestamp = timestamp;
+    hover_direction = 1;
+    startAnimation();
+}
+
+void InteractiveButtonItem::leave(qint64 timestamp)
+{
+    hovering = false;
+    hover_from_progress = hover_progress;
+    hover_from_timestamp = timestamp;
+    hover_direction = -1;
+    startAnimation();
+}
+
+/**
+ * 鼠标按下，添加水波纹
+ * @param pos 相对于按钮项左上角的坐标
+ */
+void InteractiveButtonItem::press(QPoint pos, qint64 timestamp)
+{
+    pressing = true;
+    if (waters.size() && waters.last().release_timestamp == 0)
+        waters.last().release_timestamp = timestamp;
+    waters << InteractiveButtonBase::Water(pos, timestamp);
+    startAnimation();
+}
+
+void InteractiveButtonItem::release(qint64 timestamp)
+{
+    pressing = false;
+    if (waters.size() && waters.last().release_timestamp == 0)
+        waters.last().release_timestamp = timestamp;
+    startAnimation();
+}
+
+/**
+ * 重绘按钮项所在的区域
+ */
+void InteractiveButtonItem::update()
+{
+    if (group)
+        group->update(geometry);
+}
+
+/**
+ * 加入容器的动画队列
+ */
+void InteractiveButtonItem::startAnimation()
+{
+    if (group)
+        group->activateItem(this);
+}
+
+InteractiveButtonItemGroup::InteractiveButtonItemGroup(QWidget *parent)
+    : QWidget(parent), hover_item(nullptr), press_item(nullptr)
+{
+    setMouseTracking(true);
+}
+
+InteractiveButtonItemGroup::~InteractiveButtonItemGroup()
+{
+    qDeleteAll(items);
+}
+
+/**
+ * 添加按钮项，容器负责释放
+ * @return 索引
+ */
+int InteractiveButtonItemGroup::addItem(InteractiveButtonItem *item)
+{
+    item->group = this;
+    items.append(item);
+    item->update();
+    return items.size() - 1;
+}
+
+InteractiveButtonItem *InteractiveButtonItemGroup::addItem(QString text, QRect geometry)
+{
+    InteractiveButtonItem* item = new InteractiveButtonItem(text, geometry);
+    addItem(item);
+    return item;
+}
+
+/**
+ * 移除并释放按钮项
+ */
+void InteractiveButtonItemGroup::removeItem(InteractiveButtonItem *item)
+{
+    if (!items.removeOne(item))
+        return ;
+    active_items.removeOne(item);
+    if (hover_item == item)
+        hover_item = nullptr;
+    if (press_item == item)
+        press_item = nullptr;
+    update(item->geometry);
+    delete item;
+}
+
+void InteractiveButtonItemGroup::clear()
+{
+    qDeleteAll(items);
+    items.clear();
+    active_items.clear();
+    hover_item = press_item = nullptr;
+    update();
+}
+
+int InteractiveButtonItemGroup::count() const
+{
+    return items.size();
+}
+
+InteractiveButtonItem *InteractiveButtonItemGroup::item(int index) const
+{
+    return items.value(index, nullptr);
+}
+
+int InteractiveButtonItemGroup::indexOf(InteractiveButtonItem *item) const
+{
+    return items.indexOf(item);
+}
+
+/**
+ * 获取坐标所在的按钮项
+ * 按各按钮项的 inArea 判断，重叠时上面的优先
+ * @param  pos 容器中的坐标
+ * @return     索引，没有则为 -1
+ */
+int InteractiveButtonItemGroup::itemIndexAt(QPoint pos) const
+{
+    for (int i = items.size() - 1; i >= 0; i--)
+    {
+        InteractiveButtonItem* item = items.at(i);
+        if (item->geometry.contains(pos) && item->inArea(pos - item->geometry.topLeft()))
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * 一次绘制所有需要重绘的按钮项
+ */
+void InteractiveButtonItemGroup::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    QRect dirty = event->rect();
+    foreach (InteractiveButtonItem* item, items)
+    {
+        if (!item->geometry.intersects(dirty))
+            continue;
+        painter.save();
+        painter.translate(item->geometry.topLeft());
+        item->paint(painter);
+        painter.restore();
+    }
+}
+
+void InteractiveButtonItemGroup::mouseMoveEvent(QMouseEvent *event)
+{
+    int index = itemIndexAt(event->pos());
+    InteractiveButtonItem* item = index > -1 ? items.at(index) : nullptr;
+    setHoverItem(item && item->enabled ? item : nullptr);
+    QWidget::mouseMoveEvent(event);
+}
+
+void InteractiveButtonItemGroup::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton)
+    {
+        int index = itemIndexAt(event->pos());
+        InteractiveButtonItem* item = index > -1 ? items.at(index) : nullptr;
+        if (item && item->enabled)
+        {
+            setHoverItem(item);
+            press_item = item;
+            item->press(event->pos() - item->geometry.topLeft(), getTimestamp());
+            emit itemPressed(index);
+        }
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void InteractiveButtonItemGroup::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && press_item)
+    {
+        InteractiveButtonItem* item = press_item;
+        press_item = nullptr;
+        item->release(getTimestamp());
+        int index = items.indexOf(item);
+        emit itemReleased(index);
+        if (item->geometry.contains(event->pos()) && item->inArea(event->pos() - item->geometry.topLeft()))
+            emit itemClicked(index);
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void InteractiveButtonItemGroup::leaveEvent(QEvent *event)
+{
+    setHoverItem(nullptr);
+    QWidget::leaveEvent(event);
+}
+
+/**
+ * 字体改变，重新排版所有按钮项的文字
+ */
+void InteractiveButtonItemGroup::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::FontChange)
+    {
+        foreach (InteractiveButtonItem* item, items)
+            item->static_text_valid = false;
+        update();
+    }
+    QWidget::changeEvent(event);
+}
+
+/**
+ * 刷新所有正在动画的按钮项，只重绘它们所在的区域
+ * 先推进所有按钮项的进度，再批量查表得到缓动后的悬浮进度
+ */
+void InteractiveButtonItemGroup::animationTick()
+{
+    qint64 timestamp = getTimestamp();
+    int count = active_items.size();
+    tick_progress.resize(count);
+    tick_levels.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        InteractiveButtonItem* item = active_items.at(i);
+        item->active = item->animate(timestamp);
+        tick_progress[i] = item->hover_progress;
+    }
+
+    // 共用样式的按钮项曲线相同，连续相同的一段一次查表
+    for (int from = 0; from < count; )
+    {
+        const EasingTable& easing = active_items.at(from)->button_style->hover_easing;
+        int to = from + 1;
+        while (to < count && active_items.at(to)->button_style->hover_easing == easing)
+            to++;
+        easing.evaluate(tick_progress.constData() + from, tick_levels.data() + from, to - from);
+        from = to;
+    }
+
+    for (int i = 0, j = 0; j < count; j++)
+    {
+        InteractiveButtonItem* item = active_items.at(i);
+        item->hover_level = tick_levels.at(j);
+        update(item->geometry);
+        if (item->active)
+            i++;
+        else
+            active_items.removeAt(i);
+    }
+    if (active_items.isEmpty())
+        ButtonAnimationDriver::instance()->unregisterTarget(this);
+}
+
+QScreen *InteractiveButtonItemGroup::animationScreen()
+{
+    QWidget* win = window();
+    if (win && win->windowHandle())
+        return win->windowHandle()->screen();
+    return nullptr;
+}
+
+/**
+ * 按钮项开始动画：加入动画队列，容器注册到动画驱动器
+ */
+void InteractiveButtonItemGroup::activateItem(InteractiveButtonItem *item)
+{
+    if (!item->active)
+    {
+        item->active = true;
+        active_items.append(item);
+    }
+    ButtonAnimationDriver::instance()->registerTarget(this);
+}
+
+/**
+ * 切换悬浮的按钮项
+ */
+void InteractiveButtonItemGroup::setHoverItem(InteractiveButtonItem *item)
+{
+    if (hover_item == item)
+        return ;
+    qint64 timestamp = getTimestamp();
+    if (hover_item)
+    {
+        hover_item->leave(timestamp);
+        emit itemLeaved(items.indexOf(hover_item));
+    }
+    hover_item = item;
+    if (hover_item)
+    {
+        hover_item->enter(timestamp);
+        emit itemEntered(items.indexOf(hover_item));
+    }
+}
+
+/**
+ * 按钮项变成不可用：结束悬浮、按下，松开时不再触发它的信号
+ */
+void InteractiveButtonItemGroup::disableItem(InteractiveButtonItem *item)
+{
+    if (hover_item == item)
+        setHoverItem(nullptr);
+    if (press_item == item)
+    {
+        press_item = nullptr;
+        item->release(getTimestamp());
+    }
+}
+
+qint64 InteractiveButtonItemGroup::getTimestamp() const
+{
+    return ButtonAnimationDriver::instance()->timestamp();
+}
@@ -0,0 +1,156 @@
+#ifndef INTERACTIVEBUTTONITEMGROUP_H
+#define INTERACTIVEBUTTONITEMGROUP_H
+
+#include <QWidget>
+#include <QList>
+#include <QIcon>
+#include <QPainter>
+#include <QPainterPath>
+#include <QMouseEvent>
+#include <QStaticText>
+#include "interactivebuttonbase.h"
+
+class InteractiveButtonItemGroup;
+
+/**
+ * 轻量级按钮项
+ * 不是控件，没有自己的绘制、事件、窗口合成开销
+ * 由 InteractiveButtonItemGroup 在一次 paintEvent 中统一绘制、统一分发鼠标事件
+ * 颜色、时长、圆角使用与 InteractiveButtonBase 相同的 InteractiveButtonStyle
+ * 悬浮渐变、水波纹的计算也与 InteractiveButtonBase 共用（时间戳进度、缓动曲线查找表）
+ * 适合键盘、日历、标签云等大量按钮的网格
+ */
+class InteractiveButtonItem
+{
+    friend class InteractiveButtonItemGroup;
+public:
+    InteractiveButtonItem(QString text = "", QRect geometry = QRect());
+    InteractiveButtonItem(QIcon icon, QRect geometry = QRect());
+    virtual ~InteractiveButtonItem();
+
+    void setGeometry(QRect geometry);
+    void setText(QString text);
+    void setIcon(QIcon icon);
+    void setBgColor(QColor hover, QColor press);
+    void setNormalColor(QColor color);
+    void setTextColor(QColor color);
+    void setRadius(int radius);
+    void setHoverAniDuration(int d);
+    void setWaterAniDuration(int press, int release, int finish);
+    void setHoverEasing(const EasingTable& easing);
+    void setWaterEasing(const EasingTable& easing);
+    void setButtonStyle(const InteractiveButtonStyle& style);
+    void setEnabled(bool enable);
+
+    QRect getGeometry() const { return geometry; }
+    QString getText() const { return text; }
+    QIcon getIcon() const { return icon; }
+    const InteractiveButtonStyle& getButtonStyle() const { return button_style; }
+    bool isEnabled() const { return enabled; }
+    bool isHovering() const { return hovering; }
+    bool isPressing() const { return pressing; }
+    InteractiveButtonItemGroup* getGroup() const { return group; }
+
+    virtual bool inArea(QPoint point) const;
+
+protected:
+    virtual QPainterPath getBgPainterPath() const;
+    virtual void paint(QPainter& painter);
+    virtual bool animate(qint64 timestamp);
+
+    void enter(qint64 timestamp);
+    void leave(qint64 timestamp);
+    void press(QPoint pos, qint64 timestamp);
+    void release(qint64 timestamp);
+
+    void update();
+    void startAnimation();
+    const QPainterPath& getCachedBgPainterPath() const;
+
+protected:
+    QRect geometry; // 在容器中的位置
+    QString text;
+    QIcon icon;
+    InteractiveButtonStyle button_style;
+    bool enabled;
+
+    // 鼠标状态
+    bool hovering, pressing;
+
+    // 悬浮渐变
+    int hover_progress;
+    float hover_level;           // 经过缓动曲线的悬浮进度（0~1），由容器每帧批量查表
+    int hover_direction;         // 1 变深，-1 变浅
+    int hover_from_progress;     // 本次渐变的起点
+    qint64 hover_from_timestamp; // 本次渐变开始的时间
+
+    // 水波纹
+    RingQueue<InteractiveButtonBase::Water> waters;
+
+private:
+    InteractiveButtonItemGroup* group;
+    bool active;                      // 是否在容器的动画队列中
+    mutable QPainterPath bg_path;     // 背景形状缓存
+    mutable bool bg_path_valid;
+    QStaticText static_text;          // 文字排版缓存
+    bool static_text_valid;
+};
+
+/**
+ * 按钮项容器
+ * 所有按钮项共用一个控件、一次 paintEvent、一个 QPainter
+ * 鼠标事件按每个按钮项的 inArea 判断，后添加的在上面
+ * 动画通过全局动画驱动器刷新，只重绘正在动画的按钮项
+ */
+class InteractiveButtonItemGroup : public QWidget, public AnimationTarget
+{
+    Q_OBJECT
+    friend class InteractiveButtonItem;
+public:
+    InteractiveButtonItemGroup(QWidget* parent = nullptr);
+    ~InteractiveButtonItemGroup() override;
+
+    int addItem(InteractiveButtonItem* item);
+    InteractiveButtonItem* addItem(QString text, QRect geometry);
+    void removeItem(InteractiveButtonItem* item);
+    void clear();
+
+    int count() const;
+    InteractiveButtonItem* item(int index) const;
+    int indexOf(InteractiveButtonItem* item) const;
+    int itemIndexAt(QPoint pos) const;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+    void changeEvent(QEvent* event) override;
+
+    void animationTick() override;
+    QScreen* animationScreen() override;
+
+private:
+    void activateItem(InteractiveButtonItem* item);
+    void setHoverItem(InteractiveButtonItem* item);
+    void disableItem(InteractiveButtonItem* item);
+    qint64 getTimestamp() const;
+
+signals:
+    void itemPressed(int index);
+    void itemReleased(int index);
+    void itemClicked(int index);
+    void itemEntered(int index);
+    void itemLeaved(int index);
+
+private:
+    QList<InteractiveButtonItem*> items;        // 绘制顺序，后面的在上面
+    QList<InteractiveButtonItem*> active_items; // 正在动画的按钮项
+    InteractiveButtonItem* hover_item;
+    InteractiveButtonItem* press_item;
+    QVector<int> tick_progress; // 每帧批量查表的输入、输出缓冲，避免重复分配
+    QVector<float> tick_levels;
+};
+
+#endif // INTERACTIVEBUTTONITEMGROUP_H
@@ -0,0 +1,150 @@
+#include "interactivebuttonstyle.h"
+#include "interactivebuttonbase.h"
+
+InteractiveButtonStyleData::InteractiveButtonStyleData()
+    : icon_color(0, 0, 0), text_color(0,0,0),
+      normal_bg(0xF2, 0xF2, 0xF2, 0), hover_bg(128, 128, 128, 32), press_bg(128, 128, 128, 64), border_bg(0,0,0,0),
+      focus_bg(0,0,0,0), focus_border(0,0,0,0),
+      hover_bg_duration(300), press_bg_duration(300), click_ani_duration(300),
+      show_duration(300), jitter_duration(300),
+      water_press_duration(800), water_release_duration(400), water_finish_duration(300),
+      hover_easing(InteractiveButtonBase::getEasingTable(InteractiveButtonBase::Linear)),
+      water_easing(InteractiveButtonBase::getEasingTable(InteractiveButtonBase::FastSlower)),
+      fore_paddings(4,4,4,4), icon_padding_proper(0.25), icon_text_padding(4),
+      border_width(1), radius_x(0), radius_y(0),
+      press_start(40), move_speed(5), elastic_coefficient(1.2)
+{
+}
+
+/**
+ * 所有默认构造的样式共用的数据
+ */
+static const QSharedDataPointer<InteractiveButtonStyleData>& defaultStyleData()
+{
+    static const QSharedDataPointer<InteractiveButtonStyleData> data(new InteractiveButtonStyleData);
+    return data;
+}
+
+InteractiveButtonStyle::InteractiveButtonStyle() : d(defaultStyleData())
+{
+}
+
+/**
+ * 以下修改函数先判断是否相同
+ * 值没变时不复制共享的数据
+ */
+void InteractiveButtonStyle::setIconColor(QColor color)
+{
+    if (d.constData()->icon_color != color)
+        d->icon_color = color;
+}
+
+void InteractiveButtonStyle::setTextColor(QColor color)
+{
+    if (d.constData()->text_color != color)
+        d->text_color = color;
+}
+
+void InteractiveButtonStyle::setNormalColor(QColor color)
+{
+    if (d.constData()->normal_bg != color)
+        d->normal_bg = color;
+}
+
+void InteractiveButtonStyle::setHoverColor(QColor color)
+{
+    if (d.constData()->hover_bg != color)
+        d->hover_bg = color;
+}
+
+void InteractiveButtonStyle::setPressColor(QColor color)
+{
+    if (d.constData()->press_bg != color)
+        d->press_bg = color;
+}
+
+void InteractiveButtonStyle::setBorderColor(QColor color)
+{
+    if (d.constData()->border_bg != color)
+        d->border_bg = color;
+}
+
+void InteractiveButtonStyle::setFocusBg(QColor color)
+{
+    if (d.constData()->focus_bg != color)
+        d->focus_bg = color;
+}
+
+void InteractiveButtonStyle::setFocusBorder(QColor color)
+{
+    if (d.constData()->focus_border != color)
+        d->focus_border = color;
+}
+
+void InteractiveButtonStyle::setHoverAniDuration(int duration)
+{
+    if (d.constData()->hover_bg_duration != duration)
+        d->hover_bg_duration = duration;
+}
+
+void InteractiveButtonStyle::setPressAniDuration(int duration)
+{
+    if (d.constData()->press_bg_duration != duration)
+        d->press_bg_duration = duration;
+}
+
+void InteractiveButtonStyle::setClickAniDuration(int duration)
+{
+    if (d.constData()->click_ani_duration != duration)
+        d->click_ani_duration = duration;
+}
+
+void InteractiveButtonStyle::setWaterAniDuration(int press, int release, int finish)
+{
+    const InteractiveButtonStyleData* data = d.constData();
+    if (data->water_press_duration == press && data->water_release_duration == release && data->water_finish_duration == finish)
+        return ;
+    d->water_press_duration = press;
+    d->water_release_duration = release;
+    d->water_finish_duration = finish;
+}
+
+void InteractiveButtonStyle::setHoverEasing(const EasingTable &easing)
+{
+    if (d.constData()->hover_easing != easing)
+        d->hover_easing = easing;
+}
+
+void InteractiveButtonStyle::setWaterEasing(const EasingTable &easing)
+{
+    if (d.constData()->water_easing != easing)
+        d->water_easing = easing;
+}
+
+void InteractiveButtonStyle::setRadius(int rx, int ry)
+{
+    if (d.constData()->radius_x == rx && d.constData()->radius_y == ry)
+        return ;
+    d->radius_x = rx;
+    d->radius_y = ry;
+}
+
+void InteractiveButtonStyle::setBorderWidth(int x)
+{
+    if (d.constData()->border_width != x)
+        d->border_width = x;
+}
+
+void InteractiveButtonStyle::setPaddings(int l, int r, int t, int b)
+{
+    EdgeVal paddings(l, t, r, b);
+    if (d.constData()->fore_paddings == paddings)
+        return ;
+    d->fore_paddings = paddings;
+}
+
+void InteractiveButtonStyle::setIconPaddingProper(double x)
+{
+    if (!qFuzzyCompare(d.constData()->icon_padding_proper, x))
+        d->icon_padding_proper = x;
+}
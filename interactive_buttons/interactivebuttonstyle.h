@@ -0,0 +1,98 @@
+#ifndef INTERACTIVEBUTTONSTYLE_H
+#define INTERACTIVEBUTTONSTYLE_H
+
+#include <QColor>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include "easingtable.h"
+
+/**
+ * 按钮样式数据
+ * 颜色、动画时长、缓动曲线、圆角、留白等很少改变、同类按钮基本相同的配置
+ */
+class InteractiveButtonStyleData : public QSharedData
+{
+public:
+    /**
+     * 四周边界的padding
+     * 调整按钮大小时：宽度+左右、高度+上下
+     */
+    struct EdgeVal
+    {
+        EdgeVal() {}
+        EdgeVal(int l, int t, int r, int b) : left(l), top(t), right(r), bottom(b) {}
+        bool operator==(const EdgeVal& o) const { return left == o.left && top == o.top && right == o.right && bottom == o.bottom; }
+        int left, top, right, bottom; // 四个边界的空白距离
+    };
+
+    InteractiveButtonStyleData();
+
+    // 背景与前景
+    QColor icon_color, text_color;                   // 前景颜色
+    QColor normal_bg, hover_bg, press_bg, border_bg; // 各种背景颜色
+    QColor focus_bg, focus_border;                   // 有焦点的颜色
+
+    // 动画时长
+    int hover_bg_duration, press_bg_duration, click_ani_duration;
+    int show_duration, jitter_duration;
+    int water_press_duration, water_release_duration, water_finish_duration;
+
+    // 缓动曲线
+    EasingTable hover_easing; // 悬浮背景渐变
+    EasingTable water_easing; // 水波纹扩散
+
+    // 形状与留白
+    EdgeVal fore_paddings;
+    double icon_padding_proper;            // 图标的大小比例
+    int icon_text_padding;                 // 图标+文字模式共存时，两者间隔
+    int border_width;
+    int radius_x, radius_y;
+
+    // 效果参数
+    int press_start;            // 按下渐变的初始进度
+    int move_speed;
+    double elastic_coefficient; // 弹性系数
+};
+
+/**
+ * 按钮样式
+ * 隐式共享：复制只增加引用计数，修改时才复制一份（写时复制）
+ * 默认构造的样式全部共用同一份默认数据，成千上万个按钮也只占一份内存
+ * 按钮单独修改某项时才拥有自己的副本；整组换肤只需把同一个样式赋给每个按钮
+ */
+class InteractiveButtonStyle
+{
+public:
+    typedef InteractiveButtonStyleData::EdgeVal EdgeVal;
+
+    InteractiveButtonStyle();
+
+    const InteractiveButtonStyleData* operator->() const { return d.constData(); }
+    bool isSharedWith(const InteractiveButtonStyle& other) const { return d.constData() == other.d.constData(); }
+
+    void setIconColor(QColor color);
+    void setTextColor(QColor color);
+    void setNormalColor(QColor color);
+    void setHoverColor(QColor color);
+    void setPressColor(QColor color);
+    void setBorderColor(QColor color);
+    void setFocusBg(QColor color);
+    void setFocusBorder(QColor color);
+
+    void setHoverAniDuration(int duration);
+    void setPressAniDuration(int duration);
+    void setClickAniDuration(int duration);
+    void setWaterAniDuration(int press, int release, int finish);
+    void setHoverEasing(const EasingTable& easing);
+    void setWaterEasing(const EasingTable& easing);
+
+    void setRadius(int rx, int ry);
+    void setBorderWidth(int x);
+    void setPaddings(int l, int r, int t, int b);
+    void setIconPaddingProper(double x);
+
+private:
+    QSharedDataPointer<InteractiveButtonStyleData> d;
+};
+
+#endif // INTERACTIVEBUTTONSTYLE_H
@@ -10,6 +10,7 @@
 
 class PointMenuButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     PointMenuButton(QWidget* parent = nullptr);
 
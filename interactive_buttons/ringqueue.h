@@ -0,0 +1,109 @@
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include <QVector>
+
+/**
+ * 固定容量的环形队列
+ * 存储空间一次性分配，之后的添加、删除都不再申请内存
+ * 队列满时添加新元素会丢弃最旧的元素
+ * 接口与 QList 的常用部分保持一致（size、at、last、<<、removeAt、clear）
+ */
+template<typename T>
+class RingQueue
+{
+public:
+    RingQueue(int capacity = 8) : head(0), count(0)
+    {
+        buffer.resize(qMax(1, capacity));
+    }
+
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    int capacity() const { return buffer.size(); }
+
+    const T& at(int i) const { return buffer.at(index(i)); }
+    T& operator[](int i) { return buffer[index(i)]; }
+    const T& operator[](int i) const { return at(i); }
+    T& first() { return (*this)[0]; }
+    const T& first() const { return at(0); }
+    T& last() { return (*this)[count - 1]; }
+    const T& last() const { return at(count - 1); }
+
+    /**
+     * 添加到队尾
+     * @return 是否因为队列已满丢弃了最旧的元素
+     */
+    bool append(const T& t)
+    {
+        bool dropped = false;
+        if (count == buffer.size())
+        {
+            head = index(1);
+            count--;
+            dropped = true;
+        }
+        buffer[index(count)] = t;
+        count++;
+        return dropped;
+    }
+
+    RingQueue& operator<<(const T& t)
+    {
+        append(t);
+        return *this;
+    }
+
+    void removeFirst()
+    {
+        head = index(1);
+        count--;
+    }
+
+    /**
+     * 删除某个位置的元素，后面的元素依次前移
+     * 可以在遍历时使用 removeAt(i--)
+     */
+    void removeAt(int i)
+    {
+        if (i == 0)
+            return removeFirst();
+        for (int j = i; j < count - 1; j++)
+            (*this)[j] = at(j + 1);
+        count--;
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    /**
+     * 修改容量，重新分配存储空间
+     * 超出新容量时保留最新的元素
+     */
+    void setCapacity(int capacity)
+    {
+        capacity = qMax(1, capacity);
+        if (capacity == buffer.size())
+            return ;
+        QVector<T> resized(capacity);
+        int keep = qMin(count, capacity);
+        for (int i = 0; i < keep; i++)
+            resized[i] = at(count - keep + i);
+        buffer.swap(resized);
+        head = 0;
+        count = keep;
+    }
+
+private:
+    int index(int i) const { return (head + i) % buffer.size(); }
+
+private:
+    QVector<T> buffer;
+    int head;  // 队首在 buffer 中的位置
+    int count; // 元素数量
+};
+
+#endif // RINGQUEUE_H
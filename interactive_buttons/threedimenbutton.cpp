@@ -1,16 +1,10 @@
 #include "threedimenbutton.h"
 
-ThreeDimenButton::ThreeDimenButton(QWidget* parent) : InteractiveButtonBase (parent)
+ThreeDimenButton::ThreeDimenButton(QWidget* parent) : InteractiveButtonBase (parent),
+    shadow_color(0x88, 0x88, 0x88, 0x64), shadow_offset(0, 0), shadow_dpr(0),
+    in_rect(false), cursor_polling(true), aop_w(width() / AOPER), aop_h(height() / AOPER)
 {
     setMouseTracking(true);
-	aop_w = width() / AOPER;
-	aop_h = height() / AOPER;
-
-    shadow_effect = new QGraphicsDropShadowEffect(this);
-	shadow_effect->setOffset(0, 0);
-	shadow_effect->setColor(QColor(0x88, 0x88, 0x88, 0x64));
-	shadow_effect->setBlurRadius(10);
-	setGraphicsEffect(shadow_effect);
 
 	setJitterAni(false);
 }
@@ -65,6 +59,7 @@ void ThreeDimenButton::mouseMoveEvent(QMouseEvent *event)
     if (is_in && !in_rect)// 鼠标移入
     {
         in_rect = true;
+        mouse_pos = event->pos(); // 进入时使用事件的位置，不再查询全局鼠标位置
         InteractiveButtonBase::enterEvent(nullptr);
     }
     else if (!is_in && in_rect && !pressing) // 鼠标移出
@@ -77,6 +72,91 @@ void ThreeDimenButton::mouseMoveEvent(QMouseEvent *event)
         InteractiveButtonBase::mouseMoveEvent(event);
 }
 
+/**
+ * 先画阴影，再画按钮
+ * 阴影只在尺寸变化时模糊一次，动画时只平移
+ */
+void ThreeDimenButton::paintEvent(QPaintEvent *event)
+{
+    if (self_enabled)
+    {
+        QPainter painter(this);
+        painter.drawPixmap(shadow_offset, getShadowPixmap(painter.device()->devicePixelRatioF()));
+    }
+    InteractiveButtonBase::paintEvent(event);
+}
+
+/**
+ * 一维盒式模糊（透明外延），用于阴影
+ * @param p      第一个像素
+ * @param stride 相邻像素的间隔
+ * @param n      像素数量
+ * @param r      模糊半径
+ * @param buffer 临时缓冲区（至少 n 个）
+ */
+static void boxBlurLine(QRgb* p, int stride, int n, int r, QRgb* buffer)
+{
+    for (int i = 0; i < n; i++)
+        buffer[i] = p[i*stride];
+    int sa = 0, sr = 0, sg = 0, sb = 0, div = r*2+1;
+    for (int i = 0; i <= r && i < n; i++)
+    {
+        sa += qAlpha(buffer[i]), sr += qRed(buffer[i]), sg += qGreen(buffer[i]), sb += qBlue(buffer[i]);
+    }
+    for (int i = 0; i < n; i++)
+    {
+        p[i*stride] = qRgba(sr / div, sg / div, sb / div, sa / div);
+        int out = i - r, in = i + r + 1;
+        if (out >= 0)
+            sa -= qAlpha(buffer[out]), sr -= qRed(buffer[out]), sg -= qGreen(buffer[out]), sb -= qBlue(buffer[out]);
+        if (in < n)
+            sa += qAlpha(buffer[in]), sr += qRed(buffer[in]), sg += qGreen(buffer[in]), sb += qBlue(buffer[in]);
+    }
+}
+
+/**
+ * 获取模糊好的阴影
+ * 按钮静止时的背景形状模糊后缓存，同尺寸、同颜色的按钮共用（QPixmapCache）
+ * 三次盒式模糊近似高斯模糊
+ * @param  dpr 设备像素比
+ * @return     阴影图片，和按钮一样大
+ */
+QPixmap ThreeDimenButton::getShadowPixmap(qreal dpr)
+{
+    if (shadow_size == size() && qFuzzyCompare(shadow_dpr, dpr) && !shadow_pixmap.isNull())
+        return shadow_pixmap;
+    shadow_size = size();
+    shadow_dpr = dpr;
+
+    QString key = QString("three_dimen_shadow_%1x%2_%3_%4_%5_%6").arg(width()).arg(height())
+            .arg(aop_w).arg(aop_h).arg(qRound(dpr * 100)).arg(shadow_color.rgba());
+    if (QPixmapCache::find(key, &shadow_pixmap))
+        return shadow_pixmap;
+
+    QImage image(size() * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.scale(dpr, dpr);
+    painter.fillRect(QRect(aop_w, aop_h, width()-aop_w*2, height()-aop_h*2), shadow_color);
+    painter.end();
+
+    int radius = qMax(1, qRound(SHADOW_BLUR * dpr / 3)); // 三次叠加约等于模糊半径
+    QVector<QRgb> buffer(qMax(image.width(), image.height()));
+    int stride = image.bytesPerLine() / 4;
+    for (int pass = 0; pass < 3; pass++)
+    {
+        for (int y = 0; y < image.height(); y++)
+            boxBlurLine(reinterpret_cast<QRgb*>(image.scanLine(y)), 1, image.width(), radius, buffer.data());
+        for (int x = 0; x < image.width(); x++)
+            boxBlurLine(reinterpret_cast<QRgb*>(image.bits()) + x, stride, image.height(), radius, buffer.data());
+    }
+
+    shadow_pixmap = QPixmap::fromImage(image);
+    shadow_pixmap.setDevicePixelRatio(dpr);
+    QPixmapCache::insert(key, shadow_pixmap);
+    return shadow_pixmap;
+}
+
 void ThreeDimenButton::resizeEvent(QResizeEvent *event)
 {
 	aop_w = width() / AOPER;
@@ -84,10 +164,56 @@ void ThreeDimenButton::resizeEvent(QResizeEvent *event)
     return InteractiveButtonBase::resizeEvent(event);
 }
 
+/**
+ * 设置是否每帧查询鼠标位置
+ * 上面有控件挡住时收不到 move 事件，需要每帧查询（所有按钮共用一次查询）
+ * 关闭后只使用鼠标事件，挡住的控件用 watchOverlapWidget 监听
+ * @param enable 开关
+ */
+void ThreeDimenButton::setCursorPolling(bool enable)
+{
+    cursor_polling = enable;
+}
+
+/**
+ * 监听挡在按钮上面的控件的鼠标事件，代替每帧查询鼠标位置
+ * 同时关闭每帧查询
+ * @param widget 挡住按钮的控件
+ */
+void ThreeDimenButton::watchOverlapWidget(QWidget *widget)
+{
+    setCursorPolling(false);
+    widget->setMouseTracking(true);
+    widget->installEventFilter(this);
+}
+
+/**
+ * 挡住按钮的控件上的鼠标移动，转换为按钮的鼠标移动
+ */
+bool ThreeDimenButton::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched != this && !cursor_polling)
+    {
+        if (event->type() == QEvent::MouseMove)
+        {
+            QMouseEvent* e = static_cast<QMouseEvent*>(event);
+            QMouseEvent mapped(QEvent::MouseMove, mapFromGlobal(e->globalPos()), e->globalPos(),
+                               e->button(), e->buttons(), e->modifiers());
+            mouseMoveEvent(&mapped);
+        }
+        else if (event->type() == QEvent::Leave)
+        {
+            leaveEvent(event);
+        }
+    }
+    return InteractiveButtonBase::eventFilter(watched, event);
+}
+
 void ThreeDimenButton::anchorTimeOut()
 {
-    // 因为上面有控件挡住了，所以需要定时监控move情况
-    mouse_pos = mapFromGlobal(QCursor::pos());
+    // 因为上面有控件挡住了，所以需要定时监控move情况（每帧所有按钮共用一次查询）
+    if (cursor_polling)
+        mouse_pos = mapFromGlobal(ButtonAnimationDriver::instance()->cursorPos());
     if (!pressing && !inArea(mouse_pos)) // 鼠标移出
     {
         InteractiveButtonBase::leaveEvent(nullptr);
@@ -95,20 +221,20 @@ void ThreeDimenButton::anchorTimeOut()
 
     InteractiveButtonBase::anchorTimeOut();
 
-    // 修改阴影的位置
-    if (offset_pos == QPoint(0,0))
-        shadow_effect->setOffset(0, 0);
+    // 修改阴影的位置（只平移，不重新模糊）
+    if (ani.offset_pos == QPoint(0,0))
+        shadow_offset = QPointF(0, 0);
     else
     {
-        if (offset_pos.manhattanLength() > SHADE)
+        if (ani.offset_pos.manhattanLength() > SHADE)
         {
-            double sx = -SHADE * offset_pos.x() / offset_pos.manhattanLength();
-            double sy = -SHADE * offset_pos.y() / offset_pos.manhattanLength();
-            shadow_effect->setOffset(sx*hover_progress/100, sy*hover_progress/100);
+            double sx = -SHADE * ani.offset_pos.x() / ani.offset_pos.manhattanLength();
+            double sy = -SHADE * ani.offset_pos.y() / ani.offset_pos.manhattanLength();
+            shadow_offset = QPointF(sx*ani.hover_progress/100, sy*ani.hover_progress/100);
         }
         else
         {
-            shadow_effect->setOffset(-offset_pos.x()*hover_progress/100, -offset_pos.y()*hover_progress/100);
+            shadow_offset = QPointF(-ani.offset_pos.x()*ani.hover_progress/100.0, -ani.offset_pos.y()*ani.hover_progress/100.0);
         }
     }
 }
@@ -116,16 +242,16 @@ void ThreeDimenButton::anchorTimeOut()
 QPainterPath ThreeDimenButton::getBgPainterPath()
 {
 	QPainterPath path;
-	if (hover_progress) // 鼠标悬浮效果
+	if (ani.hover_progress) // 鼠标悬浮效果
 	{
 		/**
 		 * 位置比例 = 悬浮比例 × 距离比例
 		 * 坐标位置 ≈ 鼠标方向偏移
 		 */
-		double hp = hover_progress / 100.0;
+		double hp = ani.hover_progress / 100.0;
 		QPoint o(width()/2, height()/2);         // 中心点
-		QPoint m = limitPointXY(mapFromGlobal(QCursor::pos())-o, width()/2, height()/2); // 当前鼠标的点
-        QPoint f = limitPointXY(offset_pos, aop_w, aop_h);  // 偏移点（压力中心）
+		QPoint m = limitPointXY(mouse_pos-o, width()/2, height()/2); // 当前鼠标的点（每帧刷新时更新）
+        QPoint f = limitPointXY(ani.offset_pos, aop_w, aop_h);  // 偏移点（压力中心）
 
 		QPoint lt, lb, rb, rt;
 		// 左上角
@@ -168,15 +294,31 @@ QPainterPath ThreeDimenButton::getBgPainterPath()
     return path;
 }
 
-QPainterPath ThreeDimenButton::getWaterPainterPath(InteractiveButtonBase::Water water)
+/**
+ * 悬浮时背景跟随鼠标变形，不能缓存
+ */
+bool ThreeDimenButton::isBgPainterPathCacheable()
+{
+    return !ani.hover_progress;
+}
+
+/**
+ * 背景跟随鼠标变形，整体重绘
+ */
+QRegion ThreeDimenButton::getDirtyRegion()
+{
+    return QRegion(rect());
+}
+
+/**
+ * 水波纹线性扩散（绘制时以倾斜后的背景为裁剪区域）
+ */
+QRect ThreeDimenButton::getWaterRect(const InteractiveButtonBase::Water& water)
 {
-    QRect circle(water.point.x() - water_radius*water.progress/100,
-                water.point.y() - water_radius*water.progress/100,
-                water_radius*water.progress/50,
-                water_radius*water.progress/50);
-    QPainterPath path;
-    path.addEllipse(circle);
-    return path & getBgPainterPath();
+    return QRect(water.point.x() - water_radius*water.progress/100,
+                 water.point.y() - water_radius*water.progress/100,
+                 water_radius*water.progress/50,
+                 water_radius*water.progress/50);
 }
 
 void ThreeDimenButton::simulateStatePress(bool s, bool a)
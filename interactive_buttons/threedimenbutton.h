@@ -2,17 +2,22 @@
 #define THREEDIMENBUTTON_H
 
 #include <QObject>
-#include <QGraphicsDropShadowEffect>
+#include <QPixmapCache>
 #include "interactivebuttonbase.h"
 
 class ThreeDimenButton : public InteractiveButtonBase
 {
 	#define AOPER 10
 	#define SHADE 10
+	#define SHADOW_BLUR 10 // 阴影模糊半径
     Q_OBJECT
 public:
     ThreeDimenButton(QWidget* parent = nullptr);
 
+    void setCursorPolling(bool enable = true);
+    bool getCursorPolling() { return cursor_polling; }
+    void watchOverlapWidget(QWidget* widget);
+
 protected:
     void enterEvent(QEvent* event) override;
     void leaveEvent(QEvent* event) override;
@@ -20,23 +25,34 @@ protected:
     void mouseReleaseEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
     void anchorTimeOut() override;
 
 	QPainterPath getBgPainterPath() override;
-	QPainterPath getWaterPainterPath(InteractiveButtonBase::Water water) override;
+    bool isBgPainterPathCacheable() override;
+    QRegion getDirtyRegion() override;
+    QRect getWaterRect(const InteractiveButtonBase::Water& water) override;
 
     void simulateStatePress(bool s = true, bool a = false) override;
     bool inArea(QPoint point) override;
 
+    QPixmap getShadowPixmap(qreal dpr);
+
 private:
 	int cha_cheng(QPoint a, QPoint b);
 	int dian_cheng(QPoint a, QPoint b);
 	QPoint limitPointXY(QPoint v, int w, int h);
 
 protected:
-	QGraphicsDropShadowEffect* shadow_effect;
+    QColor shadow_color;   // 阴影颜色
+    QPointF shadow_offset; // 阴影跟随鼠标的偏移
+    QPixmap shadow_pixmap; // 模糊好的阴影（同尺寸的按钮共用）
+    QSize shadow_size;     // 阴影对应的按钮尺寸
+    qreal shadow_dpr;      // 阴影对应的设备像素比
     bool in_rect;
+    bool cursor_polling; // 每帧查询鼠标位置（被其他控件挡住时也能跟随鼠标）
     int aop_w, aop_h;
 };
 
@@ -85,12 +85,6 @@ QPainterPath WaterCircleButton::getBgPainterPath()
     return path;
 }
 
-QPainterPath WaterCircleButton::getWaterPainterPath(InteractiveButtonBase::Water water)
-{
-    QPainterPath path = InteractiveButtonBase::getWaterPainterPath(water) & getBgPainterPath();
-    return path;
-}
-
 void WaterCircleButton::simulateStatePress(bool s)
 {
     in_circle = true;
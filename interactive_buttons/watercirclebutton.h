@@ -7,6 +7,7 @@
 
 class WaterCircleButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WaterCircleButton(QWidget* parent = nullptr);
     WaterCircleButton(QIcon icon, QWidget* parent = nullptr);
@@ -21,7 +22,6 @@ protected:
     void resizeEvent(QResizeEvent* event) override;
 
     QPainterPath getBgPainterPath() override;
-    QPainterPath getWaterPainterPath(Water water) override;
 
     void simulateStatePress(bool s = true);
     bool inArea(QPoint point) override;
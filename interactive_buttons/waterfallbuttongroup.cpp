@@ -1,7 +1,12 @@
 #include "waterfallbuttongroup.h"
+#include <algorithm>
+
+#define WATERFALL_SPACE_H 3 // 同一行标签的横向间距
+#define WATERFALL_SPACE_V 3 // 行与行的纵向间距
 
 WaterFallButtonGroup::WaterFallButtonGroup(QWidget *parent)
     : QWidget(parent),
+      visible_from(0), visible_to(0), layout_width(-1), batching(false),
       normal_bg(128,128,128,32),
       hover_bg(100,149,237,128),
       press_bg(100,149,237),
@@ -9,69 +14,77 @@ WaterFallButtonGroup::WaterFallButtonGroup(QWidget *parent)
       normal_ft(0,0,0),
       selected_ft(255,255,255)
 {
-
+    updateStyles();
 }
 
+/**
+ * 批量添加标签，全部添加完后只排版一次
+ */
 void WaterFallButtonGroup::initStringList(QStringList list, QStringList selected)
 {
+    QSet<QString> selected_set;
+    foreach (QString s, selected)
+        selected_set.insert(s);
+
+    int start = tags.size();
+    tags.reserve(start + list.size());
+    batching = true;
     foreach (QString s, list)
     {
-        addButton(s, selected.contains(s));
+        addButton(s, selected_set.contains(s));
     }
+    batching = false;
+    layoutFrom(start);
 }
 
 void WaterFallButtonGroup::setSelects(QStringList list)
 {
-    foreach (InteractiveButtonBase *btn, btns)
+    QSet<QString> selected_set;
+    foreach (QString s, list)
+        selected_set.insert(s);
+
+    for (int i = 0; i < tags.size(); i++)
     {
-        if (btn->getText().isEmpty())
+        const Tag& tag = tags.at(i);
+        if (tag.text.isEmpty())
             continue;
-        if (list.contains(btn->getText()) && !btn->getState())
-            selectBtn(btn);
-        else if (!list.contains(btn->getText()) && btn->getState())
-            selectBtn(btn);
+        if (selected_set.contains(tag.text) != tag.selected)
+            selectTag(i);
     }
 }
 
 void WaterFallButtonGroup::addButton(QString s, bool selected)
 {
-    WaterFloatButton* btn = new WaterFloatButton(s, this);
-    btn->setFixedForeSize();
-    setBtnColors(btn);
-    btns.append(btn);
-
-    if (selected)
-        selectBtn(btn);
-
-    btn->setAutoTextColor(false);
-    connect(btn, &InteractiveButtonBase::clicked, this, [=]{
-        selectBtn(btn);
-        if (btn->getState())
-            emit signalSelected(s);
-        else
-            emit signalUnselected(s);
-    });
+    addButton(s, QColor(), selected);
 }
 
+/**
+ * 添加标签
+ * 只记录数据并排版最后一行，是否创建按钮取决于它是否在可见区域内
+ */
 void WaterFallButtonGroup::addButton(QString s, QColor c, bool selected)
 {
-    WaterFloatButton* btn = new WaterFloatButton(s, this);
-    btn->setFixedForeSize();
-    setBtnColors(btn);
-    btns.append(btn);
+    Tag tag;
+    tag.text = s;
+    tag.text_color = c;
+    tag.selected = selected;
+    tag.geometry = QRect(QPoint(0, 0), measureTag(s));
+    tags.append(tag);
 
-    if (selected)
-        selectBtn(btn);
+    if (!batching)
+        layoutFrom(tags.size() - 1);
+}
 
-    btn->setAutoTextColor(false);
-    btn->setTextColor(c);
-    connect(btn, &InteractiveButtonBase::clicked, this, [=]{
-        selectBtn(btn);
-        if (btn->getState())
-            emit signalSelected(s);
-        else
-            emit signalUnselected(s);
-    });
+/**
+ * 移除所有标签，按钮回收待复用
+ */
+void WaterFallButtonGroup::clear()
+{
+    for (int i = visible_from; i < visible_to; i++)
+        releaseButton(i);
+    tags.clear();
+    visible_from = visible_to = 0;
+    updateFixedHeight();
 }
 
 void WaterFallButtonGroup::setColors(QColor normal_bg, QColor hover_bg, QColor press_bg, QColor selected_bg, QColor normal_ft, QColor selected_ft)
@@ -85,40 +98,285 @@ void WaterFallButtonGroup::setColors(QColor normal_bg, QColor hover_bg, QColor p
         this->selected_ft = selected_ft;
     else
         selected_ft = getReverseColor(selected_bg);
+    updateStyles();
+
+    // 只有显示中的按钮需要更新，其余的在绑定时设置
+    for (QHash<int, WaterFloatButton*>::const_iterator it = visible_btns.constBegin(); it != visible_btns.constEnd(); ++it)
+        setBtnColors(it.value(), tags.at(it.key()));
+}
+
+int WaterFallButtonGroup::count() const
+{
+    return tags.size();
 }
 
+bool WaterFallButtonGroup::isSelected(int index) const
+{
+    return index >= 0 && index < tags.size() && tags.at(index).selected;
+}
+
+/**
+ * 全部重新排版
+ */
 void WaterFallButtonGroup::updateButtonPositions()
 {
-    const int space_h = 3, space_v = 3;
-    int total_w = this->width(), w = space_v;
-    int total_h = 0;
-    // 自动调整位置
-    foreach (InteractiveButtonBase* btn, btns)
+    layout_width = -1;
+    layoutFrom(0);
+}
+
+/**
+ * 根据可见区域分配、回收按钮
+ * 放在滚动区域中时，滚动会移动本控件，由 moveEvent 自动调用
+ * 嵌套在其他会滚动的控件中时，需要手动调用
+ */
+void WaterFallButtonGroup::updateVisibleButtons()
+{
+    QRect visible = getVisibleRect();
+    int from = 0, to = 0;
+    if (!visible.isEmpty() && !tags.isEmpty())
     {
-        int btn_w = btn->width();
-        if (w == 0 || w + btn_w <= total_w) // 开头，或者同一行
+        // 上下各预留一屏，避免小幅滚动时反复回收
+        int top = visible.top() - visible.height(), bottom = visible.bottom() + visible.height();
+        QVector<Tag>::const_iterator first = std::partition_point(tags.constBegin(), tags.constEnd(), [=](const Tag& tag) {
+            return tag.geometry.bottom() < top;
+        });
+        QVector<Tag>::const_iterator last = std::partition_point(first, tags.constEnd(), [=](const Tag& tag) {
+            return tag.geometry.top() <= bottom;
+        });
+        from = static_cast<int>(first - tags.constBegin());
+        to = static_cast<int>(last - tags.constBegin());
+    }
+
+    // 回收离开范围的按钮
+    for (int i = visible_from; i < visible_to; i++)
+    {
+        if (i < from || i >= to)
+            releaseButton(i);
+    }
+
+    // 范围内没有按钮的标签分配按钮，已有的跟随排版
+    for (int i = from; i < to; i++)
+    {
+        WaterFloatButton* btn = visible_btns.value(i, nullptr);
+        if (!btn)
         {
-            btn->move(w, total_h);
-            w += btn_w + space_h;
+            bindButton(free_btns.isEmpty() ? createButton() : free_btns.takeLast(), i);
         }
-        else // 另起一行
+        else
         {
-            total_h += btn->height() + space_v;
-            w = space_h;
-            btn->move(w, total_h);
-            w += btn_w + space_h;
+            const QRect& geometry = tags.at(i).geometry;
+            btn->setFixedSize(geometry.size());
+            btn->move(geometry.topLeft());
         }
     }
-    if (btns.size())
-        total_h += btns.last()->height();
-    this->setFixedHeight(total_h);
+    visible_from = from;
+    visible_to = to;
 }
 
+/**
+ * 宽度改变才需要重新排版，否则只是可见区域变了
+ */
 void WaterFallButtonGroup::resizeEvent(QResizeEvent *event)
 {
-    updateButtonPositions();
-
     QWidget::resizeEvent(event);
+
+    if (width() != layout_width)
+        layoutFrom(0);
+    else
+        updateVisibleButtons();
+}
+
+void WaterFallButtonGroup::moveEvent(QMoveEvent *event)
+{
+    QWidget::moveEvent(event);
+
+    updateVisibleButtons();
+}
+
+/**
+ * 显示时祖先控件可能还没有全部显示，可见区域延后计算
+ */
+void WaterFallButtonGroup::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    QMetaObject::invokeMethod(this, "updateVisibleButtons", Qt::QueuedConnection);
+}
+
+/**
+ * 字体改变，重新测量所有标签
+ */
+void WaterFallButtonGroup::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::FontChange)
+    {
+        for (int i = 0; i < tags.size(); i++)
+            tags[i].geometry.setSize(measureTag(tags.at(i).text));
+        updateButtonPositions();
+    }
+
+    QWidget::changeEvent(event);
+}
+
+/**
+ * 标签尺寸，与 WaterFloatButton::setFixedForeSize 的计算方式相同
+ */
+QSize WaterFallButtonGroup::measureTag(const QString &text) const
+{
+    QFontMetrics fm(font());
+    const InteractiveButtonStyle::EdgeVal& paddings = normal_style->fore_paddings;
+    return QSize(fm.horizontalAdvance(text) + paddings.left + paddings.right,
+                 fm.lineSpacing() + paddings.top + paddings.bottom);
+}
+
+/**
+ * 从指定标签所在的行开始重新排版
+ * 宽度没变时，某一行的开头回到原来的位置，后面的都不会变，提前结束
+ * @param index 第一个尺寸或内容有变化的标签
+ */
+void WaterFallButtonGroup::layoutFrom(int index)
+{
+    bool full = (width() != layout_width);
+    layout_width = width();
+    if (full)
+        index = 0;
+
+    // 回到上一个标签所在行的开头
+    int start = qMax(0, index), x = WATERFALL_SPACE_H, y = 0;
+    if (start > 0 && start <= tags.size())
+    {
+        y = tags.at(start - 1).geometry.y();
+        while (start > 0 && tags.at(start - 1).geometry.y() == y)
+            start--;
+    }
+
+    int row_h = 0;
+    for (int i = start; i < tags.size(); i++)
+    {
+        Tag& tag = tags[i];
+        int w = tag.geometry.width();
+        if (x > WATERFALL_SPACE_H && x + w > layout_width) // 另起一行
+        {
+            y += row_h + WATERFALL_SPACE_V;
+            x = WATERFALL_SPACE_H;
+            row_h = 0;
+        }
+        if (!full && i > index && x == WATERFALL_SPACE_H && tag.geometry.topLeft() == QPoint(x, y))
+            break;
+        tag.geometry.moveTo(x, y);
+        x += w + WATERFALL_SPACE_H;
+        row_h = qMax(row_h, tag.geometry.height());
+    }
+
+    updateFixedHeight();
+    updateVisibleButtons();
+}
+
+void WaterFallButtonGroup::updateFixedHeight()
+{
+    int total_h = tags.isEmpty() ? 0 : tags.last().geometry.bottom() + 1;
+    if (total_h != minimumHeight() || total_h != maximumHeight())
+        setFixedHeight(total_h);
+}
+
+/**
+ * 本控件在屏幕上实际可见的部分（已被各级父控件裁剪）
+ */
+QRect WaterFallButtonGroup::getVisibleRect() const
+{
+    if (!isVisible())
+        return QRect();
+    return visibleRegion().boundingRect();
+}
+
+WaterFloatButton *WaterFallButtonGroup::createButton()
+{
+    WaterFloatButton* btn = new WaterFloatButton(this);
+    btn->setAutoTextColor(false);
+    connect(btn, &InteractiveButtonBase::clicked, this, [=]{
+        int index = btn_tags.value(btn, -1);
+        if (index < 0)
+            return ;
+        selectTag(index);
+        if (tags.at(index).selected)
+            emit signalSelected(tags.at(index).text);
+        else
+            emit signalUnselected(tags.at(index).text);
+    });
+    return btn;
+}
+
+/**
+ * 让按钮显示指定的标签
+ * 新绑定的按钮从初始状态开始，不保留上一个标签的动画
+ */
+void WaterFallButtonGroup::bindButton(WaterFloatButton *btn, int index)
+{
+    const Tag& tag = tags.at(index);
+    btn->resetAnimationState();
+    btn->setText(tag.text);
+    btn->setFixedSize(tag.geometry.size());
+    btn->move(tag.geometry.topLeft());
+    btn->setState(tag.selected);
+    setBtnColors(btn, tag);
+    visible_btns.insert(index, btn);
+    btn_tags.insert(btn, index);
+    btn->show();
+}
+
+/**
+ * 标签离开可见区域，按钮隐藏并放回待复用列表
+ */
+void WaterFallButtonGroup::releaseButton(int index)
+{
+    WaterFloatButton* btn = visible_btns.take(index);
+    if (!btn)
+        return ;
+    btn_tags.remove(btn);
+    btn->hide();
+    btn->resetAnimationState(); // 点击、水波纹进行到一半的状态不能带到下一个标签
+    free_btns.append(btn);
+}
+
+/**
+ * 根据颜色生成未选中、选中两种样式
+ */
+void WaterFallButtonGroup::updateStyles()
+{
+    normal_style = WaterFloatButton::defaultStyle();
+    normal_style.setNormalColor(normal_bg);
+    normal_style.setHoverColor(hover_bg);
+    normal_style.setPressColor(press_bg);
+    normal_style.setTextColor(normal_ft);
+
+    selected_style = normal_style;
+    selected_style.setNormalColor(selected_bg);
+}
+
+/**
+ * 按钮共用组的样式，只有自定义文字颜色的标签单独复制一份
+ */
+void WaterFallButtonGroup::setBtnColors(InteractiveButtonBase *btn, const Tag &tag)
+{
+    btn->setButtonStyle(tag.selected ? selected_style : normal_style);
+    if (tag.text_color.isValid())
+        btn->setTextColor(tag.text_color);
+}
+
+/**
+ * 切换标签的选中状态，有按钮显示时同步到按钮
+ */
+void WaterFallButtonGroup::selectTag(int index)
+{
+    Tag& tag = tags[index];
+    tag.selected = !tag.selected;
+
+    WaterFloatButton* btn = visible_btns.value(index, nullptr);
+    if (btn)
+    {
+        btn->setState(tag.selected);
+        setBtnColors(btn, tag);
+    }
 }
 
 QColor WaterFallButtonGroup::getReverseColor(QColor color)
@@ -139,24 +397,3 @@ int WaterFallButtonGroup::getReverseChannel(int x)
     else // if (x > 128)
         return 0;
 }
-
-void WaterFallButtonGroup::setBtnColors(InteractiveButtonBase *btn)
-{
-    btn->setBgColor(normal_bg);
-    btn->setBgColor(hover_bg, press_bg);
-}
-
-void WaterFallButtonGroup::selectBtn(InteractiveButtonBase *btn)
-{
-    btn->setState(!btn->getState());
-    if (btn->getState()) // 选中
-    {
-        btn->setBgColor(selected_bg);
-//        btn->setTextColor(selected_ft);
-    }
-    else
-    {
-        btn->setBgColor(normal_bg);
-//        btn->setTextColor(normal_ft);
-    }
-}
@@ -1,8 +1,17 @@
 #ifndef WATERFALLBUTTONGROUP_H
 #define WATERFALLBUTTONGROUP_H
 
+#include <QHash>
+#include <QSet>
+#include <QVector>
 #include "waterfloatbutton.h"
 
+/**
+ * 瀑布流标签组
+ * 标签只保存文字、颜色、选中状态和位置，不是控件
+ * 只有可见区域（含上下各一屏的预留）内的标签才分配 WaterFloatButton，滚动时回收复用
+ * 添加标签只排版新增的部分，适合上万个标签的筛选面板
+ */
 class WaterFallButtonGroup : public QWidget
 {
     Q_OBJECT
@@ -13,28 +22,62 @@ public:
     void setSelects(QStringList list);
     void addButton(QString s, bool selected = false);
     void addButton(QString s, QColor c, bool selected = false);
+    void clear();
 
     void setColors(QColor normal_bg, QColor hover_bg, QColor press_bg, QColor selected_bg, QColor normal_ft, QColor selected_ft = Qt::transparent);
 
+    int count() const;
+    bool isSelected(int index) const;
+
     void updateButtonPositions();
 
+public slots:
+    void updateVisibleButtons();
+
 protected:
     void resizeEvent(QResizeEvent *event) override;
+    void moveEvent(QMoveEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void changeEvent(QEvent *event) override;
 
 private:
+    struct Tag
+    {
+        QString text;
+        QColor text_color; // 无效则使用 normal_ft
+        bool selected;
+        QRect geometry;
+    };
+
+    QSize measureTag(const QString& text) const;
+    void layoutFrom(int index);
+    void updateFixedHeight();
+    QRect getVisibleRect() const;
+    WaterFloatButton* createButton();
+    void bindButton(WaterFloatButton* btn, int index);
+    void releaseButton(int index);
+    void updateStyles();
+    void setBtnColors(InteractiveButtonBase* btn, const Tag& tag);
+    void selectTag(int index);
+
     QColor getReverseColor(QColor color);
     int getReverseChannel(int x);
-    void setBtnColors(InteractiveButtonBase* btn);
-    void selectBtn(InteractiveButtonBase* btn);
 
 signals:
 	void signalSelected(QString s);
     void signalUnselected(QString s);
 
 private:
-    QList<InteractiveButtonBase*>btns;
+    QVector<Tag> tags;                               // 按排版顺序，纵坐标单调不减
+    QHash<int, WaterFloatButton*> visible_btns;      // 标签索引 → 正在显示它的按钮
+    QHash<InteractiveButtonBase*, int> btn_tags;     // 按钮 → 标签索引
+    QList<WaterFloatButton*> free_btns;              // 回收待复用的按钮
+    int visible_from, visible_to;                    // 已绑定按钮的标签范围 [from, to)
+    int layout_width;                                // 上次排版时的宽度
+    bool batching;                                   // 批量添加中，结束后统一排版
 
     QColor normal_bg, hover_bg, press_bg, selected_bg, normal_ft, selected_ft;
+    InteractiveButtonStyle normal_style, selected_style; // 所有按钮共用，换色时整体替换
 };
 
 #endif // WATERFALLBUTTONGROUP_H
@@ -4,14 +4,37 @@ WaterFloatButton::WaterFloatButton(QWidget *parent) : InteractiveButtonBase(pare
         in_area(false), mwidth(16), radius(8)
 {
     fore_enabled = false;
-    fore_paddings.left = fore_paddings.right = radius;
+    button_style = defaultStyle();
 }
 
 WaterFloatButton::WaterFloatButton(QString s, QWidget *parent) : InteractiveButtonBase(s, parent),
         in_area(false), mwidth(16), radius(8)
 {
     fore_enabled = false;
-    fore_paddings.left = fore_paddings.right = radius;
+    button_style = defaultStyle();
+}
+
+/**
+ * 回收复用时鼠标也不在椭圆内了
+ */
+void WaterFloatButton::resetAnimationState()
+{
+    InteractiveButtonBase::resetAnimationState();
+    in_area = false;
+}
+
+/**
+ * 椭圆按钮共用的默认样式：左右各留出半圆的宽度
+ * 大量标签按钮共用一份，不必每个按钮都复制
+ */
+InteractiveButtonStyle WaterFloatButton::defaultStyle()
+{
+    static const InteractiveButtonStyle float_style = [] {
+        InteractiveButtonStyle style;
+        style.setPaddings(8, 8, style->fore_paddings.top, style->fore_paddings.bottom);
+        return style;
+    }();
+    return float_style;
 }
 
 void WaterFloatButton::enterEvent(QEvent *event)
@@ -88,9 +111,9 @@ void WaterFloatButton::paintEvent(QPaintEvent *event)
     painter.setRenderHint(QPainter::Antialiasing,true);
 
     // 鼠标悬浮进度
-    QColor edge_color = hover_bg;
+    QColor edge_color = button_style->hover_bg;
     int pro = 0;
-    if (hover_progress > 0 || press_progress || waters.size())
+    if (ani.hover_progress > 0 || ani.press_progress || waters.size())
     {
         if (water_animation)
         {
@@ -99,13 +122,13 @@ void WaterFloatButton::paintEvent(QPaintEvent *event)
               * 而如果是点一下立马移开，文字会出现一种“渐隐渐现”的效果
               */
             if (waters.size())
-                pro = max(hover_progress, waters.last().progress);
+                pro = max(ani.hover_progress, waters.last().progress);
             else
-                pro = hover_progress;
+                pro = ani.hover_progress;
         }
         else
         {
-            max(hover_progress, press_progress);
+            max(ani.hover_progress, ani.press_progress);
         }
         edge_color.setAlpha(255 * (100 - pro) / 100);
     }
@@ -114,12 +137,12 @@ void WaterFloatButton::paintEvent(QPaintEvent *event)
     QPainterPath path;
     if (show_foreground)
     {
-        path = getBgPainterPath(); // 整体背景
+        path = getCachedBgPainterPath(); // 整体背景
 
         // 出现动画
-        if (show_ani_appearing && show_ani_progress != 100 && border_bg.alpha() != 0)
+        if (ani.show_ani_appearing && ani.show_ani_progress != 100 && button_style->border_bg.alpha() != 0)
         {
-            int pw = size().width() * show_ani_progress / 100;
+            int pw = size().width() * ani.show_ani_progress / 100;
             QRect rect(0, 0, pw, size().height());
             QPainterPath rect_path;
             rect_path.addRect(rect);
@@ -130,9 +153,9 @@ void WaterFloatButton::paintEvent(QPaintEvent *event)
             x = - water_radius * x / gen; // 动画起始中心点横坐标 反向
             y = - water_radius * y / gen; // 动画起始中心点纵坐标 反向
         }
-        if (border_bg.alpha() != 0) // 如果有背景，则不进行画背景线条
+        if (button_style->border_bg.alpha() != 0) // 如果有背景，则不进行画背景线条
         {
-            painter.setPen(border_bg);
+            painter.setPen(button_style->border_bg);
             painter.drawPath(path);
         }
     }
@@ -146,28 +169,22 @@ void WaterFloatButton::paintEvent(QPaintEvent *event)
         {
             if (auto_text_color)
             {
-                QColor aim_color = isLightColor(hover_bg) ? QColor(0, 0, 0) : QColor(255, 255, 255);
+                QColor aim_color = isLightColor(button_style->hover_bg) ? QColor(0, 0, 0) : QColor(255, 255, 255);
                 color = QColor(
-                    text_color.red() + (aim_color.red() - text_color.red()) * pro / 100,
-                    text_color.green() + (aim_color.green() - text_color.green()) * pro / 100,
-                    text_color.blue() + (aim_color.blue() - text_color.blue()) * pro / 100,
+                    button_style->text_color.red() + (aim_color.red() - button_style->text_color.red()) * pro / 100,
+                    button_style->text_color.green() + (aim_color.green() - button_style->text_color.green()) * pro / 100,
+                    button_style->text_color.blue() + (aim_color.blue() - button_style->text_color.blue()) * pro / 100,
                     255);
             }
             painter.setPen(color);
         }
         else
         {
-            color = text_color;
+            color = button_style->text_color;
             color.setAlpha(255);
         }
         painter.setPen(color);
-        if (font_size > 0)
-        {
-            QFont font = painter.font();
-            font.setPointSize(font_size);
-            painter.setFont(font);
-        }
-        painter.drawText(rect, Qt::AlignCenter, text);
+        drawForeText(painter, rect, Qt::AlignCenter, text);
     }
 }
 
@@ -187,10 +204,12 @@ QPainterPath WaterFloatButton::getBgPainterPath()
     return path1 | path2 | path3;
 }
 
-QPainterPath WaterFloatButton::getWaterPainterPath(InteractiveButtonBase::Water water)
+/**
+ * 文字颜色跟随悬浮和水波纹进度渐变，整体重绘
+ */
+QRegion WaterFloatButton::getDirtyRegion()
 {
-    QPainterPath path = InteractiveButtonBase::getWaterPainterPath(water) & getBgPainterPath();
-    return path;
+    return QRegion(rect());
 }
 
 bool WaterFloatButton::inArea(QPoint point)
@@ -5,10 +5,15 @@
 
 class WaterFloatButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WaterFloatButton(QWidget* parent = nullptr);
     WaterFloatButton(QString s, QWidget* parent = nullptr);
 
+    static InteractiveButtonStyle defaultStyle();
+
+    void resetAnimationState() override;
+
 protected:
     void enterEvent(QEvent* event) override;
     void leaveEvent(QEvent* event) override;
@@ -19,7 +24,7 @@ protected:
     void paintEvent(QPaintEvent *event) override;
 
     QPainterPath getBgPainterPath() override;
-    QPainterPath getWaterPainterPath(Water water) override;
+    QRegion getDirtyRegion() override;
 
     bool inArea(QPoint point) override;
 
@@ -17,6 +17,7 @@ WaterZoomButton::WaterZoomButton(QWidget *parent) : InteractiveButtonBase(parent
 void WaterZoomButton::setChoking(int c)
 {
     choking = c;
+    invalidateBgPainterPath();
 }
 
 int WaterZoomButton::getChokingSpacing()
@@ -33,11 +34,13 @@ void WaterZoomButton::setChokingProp(double p)
 {
     choking = min(width(), height()) * p;
     choking_prop = p;
+    invalidateBgPainterPath();
 }
 
 void WaterZoomButton::setRadiusZoom(int radius)
 {
     radius_zoom = radius;
+    invalidateBgPainterPath();
 }
 
 void WaterZoomButton::setRadius(int x, int x2)
@@ -45,6 +48,7 @@ void WaterZoomButton::setRadius(int x, int x2)
     // 注意：最终绘制中只计算 x 的半径，无视 y 的半径
     InteractiveButtonBase::setRadius(x);
     radius_zoom = x2;
+    invalidateBgPainterPath();
 }
 
 QPainterPath WaterZoomButton::getBgPainterPath()
@@ -52,16 +56,16 @@ QPainterPath WaterZoomButton::getBgPainterPath()
     QPainterPath path;
     int c;
     int r;
-    if (!hover_progress)
+    if (!ani.hover_progress)
     {
         c = choking;
-        r = radius_x;
+        r = button_style->radius_x;
     }
     else
     {
-        c = choking * (1 - getNolinearProg(hover_progress, hovering?FastSlower:SlowFaster));
-        r = radius_zoom < 0 ? radius_x :
-                              radius_x + (radius_zoom-radius_x) * hover_progress / 100;
+        c = choking * (1 - getNolinearProg(ani.hover_progress, hovering?FastSlower:SlowFaster));
+        r = radius_zoom < 0 ? button_style->radius_x :
+                              button_style->radius_x + (radius_zoom-button_style->radius_x) * ani.hover_progress / 100;
     }
 
     if (r)
@@ -71,6 +75,16 @@ QPainterPath WaterZoomButton::getBgPainterPath()
     return path;
 }
 
+/**
+ * 形状随悬浮进度缩放，以进度（和方向）作为缓存的键值
+ */
+qint64 WaterZoomButton::getBgPainterPathKey()
+{
+    if (!ani.hover_progress)
+        return 0;
+    return ani.hover_progress * 2 + (hovering ? 1 : 0);
+}
+
 void WaterZoomButton::resizeEvent(QResizeEvent *event)
 {
     InteractiveButtonBase::resizeEvent(event);
@@ -78,5 +92,6 @@ void WaterZoomButton::resizeEvent(QResizeEvent *event)
     if (qAbs(choking_prop)>0.0001)
     {
         choking = min(width(), height()) * choking_prop;
+        invalidateBgPainterPath();
     }
 }
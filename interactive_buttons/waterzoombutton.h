@@ -8,6 +8,7 @@ const int DEFAULT_CHOKING = 5;
 
 class WaterZoomButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WaterZoomButton(QString text, QWidget* parent = nullptr);
     WaterZoomButton(QWidget* parent = nullptr);
@@ -22,6 +23,7 @@ public:
 
 protected:
     QPainterPath getBgPainterPath() override;
+    qint64 getBgPainterPathKey() override;
     void resizeEvent(QResizeEvent *event) override;
 
 protected:
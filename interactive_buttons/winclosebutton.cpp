@@ -14,11 +14,11 @@ void WinCloseButton::paintEvent(QPaintEvent *event)
 
     int w = _w, h = _h;
     int l = _l+w/3, t = _t+h/3, r = w*2/3, b = h*2/3;
-    int mx = _l+w/2+offset_pos.x(), my = _t+h/2+offset_pos.y();
+    int mx = _l+w/2+ani.offset_pos.x(), my = _t+h/2+ani.offset_pos.y();
 
-    if (click_ani_appearing || click_ani_disappearing)
+    if (ani.click_ani_appearing || ani.click_ani_disappearing)
     {
-        double pro = click_ani_progress / 100.0;
+        double pro = ani.click_ani_progress / 100.0;
         l -= l * pro;
         t -= t * pro;
         r += (w-r) * pro;
@@ -26,9 +26,9 @@ void WinCloseButton::paintEvent(QPaintEvent *event)
     }
 
     QPainter painter(this);
-    painter.setPen(QPen(icon_color));
+    painter.setPen(QPen(button_style->icon_color));
     painter.setRenderHint(QPainter::Antialiasing,true);
-    if (offset_pos != QPoint(0,0))
+    if (ani.offset_pos != QPoint(0,0))
     {
         QPainterPath path;
         path.moveTo(QPoint(l,t));
@@ -51,6 +51,7 @@ void WinCloseButton::paintEvent(QPaintEvent *event)
 void WinCloseButton::setTopRightRadius(int r)
 {
     tr_radius = r;
+    invalidateBgPainterPath();
 }
 
 QPainterPath WinCloseButton::getBgPainterPath()
@@ -67,8 +68,3 @@ QPainterPath WinCloseButton::getBgPainterPath()
     path -= corner_path;
     return path;
 }
-
-QPainterPath WinCloseButton::getWaterPainterPath(Water water)
-{
-    return InteractiveButtonBase::getWaterPainterPath(water) & WinCloseButton::getBgPainterPath();
-}
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 class WinCloseButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WinCloseButton(QWidget* parent = nullptr);
 
@@ -17,7 +18,6 @@ protected:
     void paintEvent(QPaintEvent*event);
 
     QPainterPath getBgPainterPath();
-    QPainterPath getWaterPainterPath(Water water);
 
 private:
 	int tr_radius;
@@ -13,11 +13,11 @@ void WinMaxButton::paintEvent(QPaintEvent *event)
     if (!show_foreground) return ; // 不显示前景
 
     int w =_w, h = _h;
-    int dx = offset_pos.x(), dy = offset_pos.y();
+    int dx = ani.offset_pos.x(), dy = ani.offset_pos.y();
     QRect r;
-    if (click_ani_appearing || click_ani_disappearing)
+    if (ani.click_ani_appearing || ani.click_ani_disappearing)
     {
-        double pro = click_ani_progress / 800.0;
+        double pro = ani.click_ani_progress / 800.0;
         r = QRect(
                     _l+(w/3+dx) - (w/3+dx)*pro,
                     _t+(h/3+dy) - (h/3+dy)*pro,
@@ -32,6 +32,6 @@ void WinMaxButton::paintEvent(QPaintEvent *event)
 
 
     QPainter painter(this);
-    painter.setPen(QPen(icon_color));
+    painter.setPen(QPen(button_style->icon_color));
     painter.drawRect(r);
 }
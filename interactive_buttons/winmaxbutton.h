@@ -6,6 +6,7 @@
 
 class WinMaxButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WinMaxButton(QWidget* parent = nullptr);
 
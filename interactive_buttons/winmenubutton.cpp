@@ -13,14 +13,14 @@ void WinMenuButton::paintEvent(QPaintEvent *event)
     if (!show_foreground) return ; // 不显示前景
 
     int w = _w, h = _h;
-    int dx = offset_pos.x(), dy = offset_pos.y();
+    int dx = ani.offset_pos.x(), dy = ani.offset_pos.y();
 
     QPainter painter(this);
-    painter.setPen(QPen(icon_color));
+    painter.setPen(QPen(button_style->icon_color));
 
-    if (click_ani_appearing)
+    if (ani.click_ani_appearing)
     {
-        double pro = click_ani_progress / 100.0;
+        double pro = ani.click_ani_progress / 100.0;
         if (!getState())
             pro = 1 - pro;
 
@@ -70,7 +70,7 @@ void WinMenuButton::paintEvent(QPaintEvent *event)
             int sy = my - half_len*sin(angle);
             int ex = mx + half_len*cos(angle);
             int ey = my + half_len*sin(angle);
-            QColor color(icon_color);
+            QColor color(button_style->icon_color);
             color.setAlpha(color.alpha() * (1-pro));
             painter.setPen(QPen(color));
             painter.drawLine(QPoint(sx,sy), QPoint(ex,ey));
@@ -7,6 +7,7 @@
 
 class WinMenuButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WinMenuButton(QWidget* parent = nullptr);
 
@@ -14,11 +14,11 @@ void WinMinButton::paintEvent(QPaintEvent* event)
 
     int w = _w, h = _h;
     QPoint left(_l+w/3, _t+h/2), right(_l+w*2/3, _t+h/2),
-           mid(_l+w/2+offset_pos.x(), _t+h/2+offset_pos.y());
+           mid(_l+w/2+ani.offset_pos.x(), _t+h/2+ani.offset_pos.y());
 
-    if (click_ani_appearing || click_ani_disappearing)
+    if (ani.click_ani_appearing || ani.click_ani_disappearing)
     {
-        double pro = click_ani_progress / 800.0;
+        double pro = ani.click_ani_progress / 800.0;
         left.setX(left.x()-left.x() * pro);
         right.setX(right.x()+(w-right.x()) * pro);
     }
@@ -27,7 +27,7 @@ void WinMinButton::paintEvent(QPaintEvent* event)
     QPainterPath path;
     path.moveTo(left);
     path.cubicTo(left, mid, right);
-    painter.setPen(QPen(icon_color));
+    painter.setPen(QPen(button_style->icon_color));
     if (left.y() != mid.y())
         painter.setRenderHint(QPainter::Antialiasing,true);
     painter.drawPath(path);
@@ -14,11 +14,11 @@ void WinRestoreButton::paintEvent(QPaintEvent* event)
 
     // 画出现一角的矩形
     int w = _w, h = _h;
-    int dx = offset_pos.x(), dy = offset_pos.y();
+    int dx = ani.offset_pos.x(), dy = ani.offset_pos.y();
     QRect br;
-    if (click_ani_appearing || click_ani_disappearing)
+    if (ani.click_ani_appearing || ani.click_ani_disappearing)
     {
-        double pro = click_ani_progress / 800.0;
+        double pro = ani.click_ani_progress / 800.0;
         br = QRect(
                     _l+(w/3+dx) - (w/3+dx)*pro,
                     _t+(h/3+dy) - (h/3+dy)*pro,
@@ -33,14 +33,14 @@ void WinRestoreButton::paintEvent(QPaintEvent* event)
 
     // 画原来的矩形
     QPainter painter(this);
-    painter.setPen(QPen(icon_color));
+    painter.setPen(QPen(button_style->icon_color));
     painter.drawRect(br);
 
     dx /= 2; dy /= 2;
     int l = _l+w*4/9+dx, t = _t+h*2/9+dy, r = _l+w*7/9+dx, b = _t+h*5/9+dy;
-    if (click_ani_appearing || click_ani_disappearing)
+    if (ani.click_ani_appearing || ani.click_ani_disappearing)
     {
-        double pro = click_ani_progress / 800.0;
+        double pro = ani.click_ani_progress / 800.0;
         l -= l*pro;
         t -= t*pro;
         r += (w-r)*pro;
@@ -86,7 +86,7 @@ void WinRestoreButton::paintEvent(QPaintEvent* event)
         path.moveTo(points.at(0));
         for (int i = 1; i < points.size(); ++i)
             path.lineTo(points.at(i));
-        QColor color(icon_color);
+        QColor color(button_style->icon_color);
         color.setAlpha(color.alpha()*0.8);
         painter.setPen(QPen(color));
         painter.drawPath(path);
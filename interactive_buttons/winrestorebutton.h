@@ -7,6 +7,7 @@
 
 class WinRestoreButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WinRestoreButton(QWidget* parent = nullptr);
 
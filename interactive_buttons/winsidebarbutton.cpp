@@ -12,24 +12,24 @@ void WinSidebarButton::paintEvent(QPaintEvent *event)
 
     if (!show_foreground) return ; // 不显示前景
 
-    int dx = offset_pos.x(), dy = offset_pos.y();
+    int dx = ani.offset_pos.x(), dy = ani.offset_pos.y();
     int l = _l + _w/3+dx, t = _t + _h/3+dy, w = _w/3, h = _h/3;
 
     QPainter painter(this);
-    painter.setPen(QPen(icon_color));
+    painter.setPen(QPen(button_style->icon_color));
     painter.setRenderHint(QPainter::Antialiasing,true);
 
-    if (click_ani_appearing)
+    if (ani.click_ani_appearing)
     {
-        double pro = click_ani_progress / 100.0;
+        double pro = ani.click_ani_progress / 100.0;
         if (getState())
             pro = 1 - pro;
         painter.drawEllipse(l+w/2-w*pro/2, t+h/2-h*pro/2, w*pro, h*pro);
 
         if (getState())
-            pro = getSpringBackProgress(click_ani_progress, 50) / 100.0;
+            pro = getSpringBackProgress(ani.click_ani_progress, 50) / 100.0;
         else
-            pro = 1 - click_ani_progress / 100.0;
+            pro = 1 - ani.click_ani_progress / 100.0;
 
         l = _l + _w/3+dx;
         t = _t + _h/3+dy;
@@ -43,13 +43,13 @@ void WinSidebarButton::paintEvent(QPaintEvent *event)
 
         QPainterPath path;
         path.addEllipse(l, t, w, h);
-        painter.fillPath(path, icon_color);
+        painter.fillPath(path, button_style->icon_color);
     }
     else if (getState())
     {
         QPainterPath path;
         path.addEllipse(l, t, w, h);
-        painter.fillPath(path, icon_color);
+        painter.fillPath(path, button_style->icon_color);
     }
     else
     {
@@ -72,6 +72,8 @@ void WinSidebarButton::slotClicked()
 void WinSidebarButton::setTopLeftRadius(int r)
 {
     tl_radius = r;
+    invalidateBgPainterPath();
+    update();
 }
 
 QPainterPath WinSidebarButton::getBgPainterPath()
@@ -88,8 +90,3 @@ QPainterPath WinSidebarButton::getBgPainterPath()
     path -= corner_path;
     return path;
 }
-
-QPainterPath WinSidebarButton::getWaterPainterPath(Water water)
-{
-    return InteractiveButtonBase::getWaterPainterPath(water) & WinSidebarButton::getBgPainterPath();
-}
\ No newline at end of file
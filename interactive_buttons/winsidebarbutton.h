@@ -7,17 +7,17 @@
 
 class WinSidebarButton : public InteractiveButtonBase
 {
+    Q_OBJECT
 public:
     WinSidebarButton(QWidget *parent = nullptr);
 
     void setTopLeftRadius(int r);
 
 protected:
-    void paintEvent(QPaintEvent*event);
-    void slotClicked();
+    void paintEvent(QPaintEvent* event) override;
+    void slotClicked() override;
 
-    QPainterPath getBgPainterPath();
-    QPainterPath getWaterPainterPath(Water water);
+    QPainterPath getBgPainterPath() override;
 
 private:
     int tl_radius;